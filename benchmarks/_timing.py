@@ -0,0 +1,56 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Timing helpers shared by the benchmark scripts."""
+
+import argparse
+import os
+import sys
+import time
+
+# Make the test data (service account keys, etc.) available to benchmarks.
+DATA_DIR = os.path.join(
+    os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "tests", "data"
+)
+SERVICE_ACCOUNT_JSON_FILE = os.path.join(DATA_DIR, "service_account.json")
+
+
+def parse_args(description, iterations=1000):
+    """Parses the common benchmark command line arguments."""
+    parser = argparse.ArgumentParser(description=description)
+    parser.add_argument(
+        "-n",
+        "--iterations",
+        type=int,
+        default=iterations,
+        help="Number of iterations per measurement.",
+    )
+    return parser.parse_args()
+
+
+def measure(func, iterations):
+    """Calls ``func`` ``iterations`` times and returns the elapsed seconds."""
+    start = time.perf_counter()
+    for _ in range(iterations):
+        func()
+    return time.perf_counter() - start
+
+
+def report(name, elapsed, iterations):
+    """Prints the per-iteration latency and throughput of a measurement."""
+    sys.stdout.write(
+        "{:<48} {:>10.1f} us/op {:>12.0f} ops/s\n".format(
+            name, elapsed / iterations * 1e6, iterations / elapsed
+        )
+    )
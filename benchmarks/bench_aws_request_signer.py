@@ -0,0 +1,68 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Throughput of :meth:`google.auth.aws.RequestSigner.get_request_options`.
+
+Signs AWS STS GetCallerIdentity requests and DynamoDB requests with a JSON
+payload, with a new signer per request (nothing cached) and with a reused
+signer (cached signing keys and URL components).
+"""
+
+import _timing
+from google.auth import aws
+
+_CREDENTIALS = {
+    "access_key_id": "AKIDEXAMPLE",
+    "secret_access_key": "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY",
+    "security_token": "session-token",
+}
+_STS_URL = (
+    "https://sts.us-east-2.amazonaws.com?Action=GetCallerIdentity&Version=2011-06-15"
+)
+_DYNAMODB_URL = "https://dynamodb.us-east-2.amazonaws.com/"
+_DYNAMODB_HEADERS = {
+    "Content-Type": "application/x-amz-json-1.0",
+    "X-Amz-Target": "DynamoDB_20120810.GetItem",
+}
+_DYNAMODB_PAYLOAD = '{"TableName":"TestTable","Key":{"Id":{"S":"1"}}}'
+
+
+def main():
+    args = _timing.parse_args(__doc__, iterations=20000)
+    signer = aws.RequestSigner("us-east-2")
+
+    def sts(request_signer):
+        request_signer.get_request_options(_CREDENTIALS, _STS_URL, "POST")
+
+    def dynamodb(request_signer):
+        request_signer.get_request_options(
+            _CREDENTIALS, _DYNAMODB_URL, "POST", _DYNAMODB_PAYLOAD, _DYNAMODB_HEADERS
+        )
+
+    for name, func in (
+        ("sts, new signer per request", lambda: sts(aws.RequestSigner("us-east-2"))),
+        ("sts, reused signer", lambda: sts(signer)),
+        (
+            "dynamodb, new signer per request",
+            lambda: dynamodb(aws.RequestSigner("us-east-2")),
+        ),
+        ("dynamodb, reused signer", lambda: dynamodb(signer)),
+    ):
+        func()
+        elapsed = _timing.measure(func, args.iterations)
+        _timing.report(name, elapsed, args.iterations)
+
+
+if __name__ == "__main__":
+    main()
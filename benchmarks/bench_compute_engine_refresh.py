@@ -0,0 +1,56 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Cost of :meth:`google.auth.compute_engine.Credentials.refresh`.
+
+Refreshes against a local fake metadata server and reports the latency and
+the number of metadata requests per refresh, with the service account info
+retrieved on every refresh (the old behaviour) and only once.
+"""
+
+from google.auth import compute_engine
+from google.auth.compute_engine import fake_metadata_server
+from google.auth.transport import requests
+
+import _timing
+
+
+def main():
+    args = _timing.parse_args(__doc__, iterations=500)
+
+    with fake_metadata_server.FakeMetadataServer() as server:
+        request = requests.Request()
+        credentials = compute_engine.Credentials()
+
+        def refresh_with_info():
+            credentials.invalidate_service_account_info()
+            credentials.refresh(request)
+
+        for name, func in (
+            ("refresh, info retrieved every time", refresh_with_info),
+            ("refresh, info cached", lambda: credentials.refresh(request)),
+        ):
+            func()
+            del server.requests[:]
+            elapsed = _timing.measure(func, args.iterations)
+            _timing.report(name, elapsed, args.iterations)
+            print(
+                "  metadata requests per refresh: {:.1f}".format(
+                    len(server.requests) / float(args.iterations)
+                )
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,97 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Cost of :func:`google.oauth2.id_token.fetch_id_token`.
+
+Compares resolving the service account credentials and minting a token on
+every call (the old behaviour) with the memoized fetch, for a rotating set of
+audiences. The token endpoint is a stub answering in-process, so the numbers
+exclude the network round-trip the memoized fetch also saves.
+"""
+
+import itertools
+import json
+import os
+import time
+
+import _timing
+
+os.environ["GOOGLE_APPLICATION_CREDENTIALS"] = _timing.SERVICE_ACCOUNT_JSON_FILE
+
+from google.auth import crypt  # noqa: E402
+from google.auth import jwt  # noqa: E402
+from google.auth import transport  # noqa: E402
+from google.oauth2 import id_token  # noqa: E402
+
+_AUDIENCES = ["https://service-{}.example.com".format(i) for i in range(40)]
+
+
+class _Response(transport.Response):
+    def __init__(self, data):
+        self._data = data
+
+    @property
+    def status(self):
+        return 200
+
+    @property
+    def headers(self):
+        return {}
+
+    @property
+    def data(self):
+        return self._data
+
+
+class _TokenEndpointStub(transport.Request):
+    """Answers ID token grants with a signed token, without any I/O."""
+
+    def __init__(self):
+        signer = crypt.RSASigner.from_service_account_file(
+            _timing.SERVICE_ACCOUNT_JSON_FILE
+        )
+        token = jwt.encode(signer, {"exp": int(time.time()) + 3600})
+        self._data = json.dumps({"id_token": token.decode()}).encode()
+
+    def __call__(self, url, method="GET", body=None, headers=None, **kwargs):
+        return _Response(self._data)
+
+
+def main():
+    args = _timing.parse_args(__doc__, iterations=400)
+    request = _TokenEndpointStub()
+    audiences = itertools.cycle(_AUDIENCES)
+
+    def uncached():
+        credentials = id_token.fetch_id_token_credentials(
+            next(audiences), request=request
+        )
+        credentials.refresh(request)
+        return credentials.token
+
+    def cached():
+        return id_token.fetch_id_token(request, next(audiences))
+
+    for name, func in (
+        ("fetch_id_token, resolved and minted per call", uncached),
+        ("fetch_id_token, memoized", cached),
+    ):
+        for _ in _AUDIENCES:
+            func()
+        elapsed = _timing.measure(func, args.iterations)
+        _timing.report(name, elapsed, args.iterations)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""RPCs per second through ``secure_authorized_aio_channel``.
+
+Runs concurrent unary RPCs against a local ``grpc.aio`` server over local
+channel credentials, with and without the authorization interceptors.
+"""
+
+import asyncio
+import time
+
+import grpc  # type: ignore
+from grpc import aio  # type: ignore
+
+import _timing
+from google.auth import _jwt_async
+from google.auth.transport import _aiohttp_requests
+from google.auth.transport import _grpc_aio
+
+_SERVICE = "google.auth.benchmark.Echo"
+_CONCURRENCY = 50
+
+
+async def _echo(request, context):
+    return request
+
+
+async def _start_server():
+    server = aio.server()
+    server.add_generic_rpc_handlers(
+        (
+            grpc.method_handlers_generic_handler(
+                _SERVICE, {"Echo": grpc.unary_unary_rpc_method_handler(_echo)}
+            ),
+        )
+    )
+    port = server.add_secure_port("localhost:0", grpc.local_server_credentials())
+    await server.start()
+    return server, "localhost:{}".format(port)
+
+
+async def _run(channel, iterations):
+    echo = channel.unary_unary("/{}/Echo".format(_SERVICE))
+    # Warm up the connection and the credentials.
+    await echo(b"ping")
+
+    async def worker(count):
+        for _ in range(count):
+            await echo(b"ping")
+
+    start = time.perf_counter()
+    await asyncio.gather(
+        *[worker(iterations // _CONCURRENCY) for _ in range(_CONCURRENCY)]
+    )
+    return time.perf_counter() - start
+
+
+async def main():
+    args = _timing.parse_args(__doc__, iterations=5000)
+    iterations = args.iterations - args.iterations % _CONCURRENCY
+    server, target = await _start_server()
+
+    credentials = _jwt_async.Credentials.from_service_account_file(
+        _timing.SERVICE_ACCOUNT_JSON_FILE, audience="https://pubsub.googleapis.com/"
+    )
+
+    try:
+        async with aio.secure_channel(
+            target, grpc.local_channel_credentials()
+        ) as channel:
+            elapsed = await _run(channel, iterations)
+        _timing.report("aio rpc without credentials", elapsed, iterations)
+
+        async with _grpc_aio.secure_authorized_aio_channel(
+            credentials,
+            _aiohttp_requests.Request(),
+            target,
+            ssl_credentials=grpc.local_channel_credentials(),
+        ) as channel:
+            elapsed = await _run(channel, iterations)
+        _timing.report("aio rpc with secure_authorized_aio_channel", elapsed, iterations)
+    finally:
+        await server.stop(None)
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -0,0 +1,101 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Per-RPC overhead of :class:`google.auth.transport.grpc.AuthMetadataPlugin`.
+
+Runs unary RPCs against a local gRPC server over local channel credentials,
+with and without the metadata plugin, using self-signed JWT service account
+credentials.
+"""
+
+from concurrent import futures
+
+import grpc  # type: ignore
+
+import _timing
+from google.auth.transport import grpc as google_auth_grpc
+from google.auth.transport import requests
+from google.oauth2 import service_account
+
+_METHOD = "/google.auth.benchmark.Echo/Echo"
+
+
+def _echo(request, context):
+    return request
+
+
+def _start_server():
+    server = grpc.server(futures.ThreadPoolExecutor(max_workers=4))
+    handler = grpc.method_handlers_generic_handler(
+        "google.auth.benchmark.Echo",
+        {"Echo": grpc.unary_unary_rpc_method_handler(_echo)},
+    )
+    server.add_generic_rpc_handlers((handler,))
+    port = server.add_secure_port("localhost:0", grpc.local_server_credentials())
+    server.start()
+    return server, "localhost:{}".format(port)
+
+
+def _rpc_loop(channel_credentials, target, iterations):
+    with grpc.secure_channel(target, channel_credentials) as channel:
+        echo = channel.unary_unary(_METHOD)
+        # Warm up the connection and the credentials.
+        echo(b"ping")
+        return _timing.measure(lambda: echo(b"ping"), iterations)
+
+
+def main():
+    args = _timing.parse_args(__doc__)
+    server, target = _start_server()
+
+    credentials = service_account.Credentials.from_service_account_file(
+        _timing.SERVICE_ACCOUNT_JSON_FILE
+    )
+    plugin = google_auth_grpc.AuthMetadataPlugin(
+        credentials, requests.Request(), default_host="pubsub.googleapis.com"
+    )
+    local = grpc.local_channel_credentials()
+
+    try:
+        baseline = _rpc_loop(local, target, args.iterations)
+        _timing.report("rpc without call credentials", baseline, args.iterations)
+
+        authorized = _rpc_loop(
+            grpc.composite_channel_credentials(
+                local, grpc.metadata_call_credentials(plugin)
+            ),
+            target,
+            args.iterations,
+        )
+        _timing.report("rpc with AuthMetadataPlugin", authorized, args.iterations)
+        _timing.report(
+            "per-rpc plugin overhead", authorized - baseline, args.iterations
+        )
+
+        headers = _timing.measure(
+            lambda: plugin._get_authorization_headers(_FakeContext()),
+            args.iterations,
+        )
+        _timing.report("plugin._get_authorization_headers", headers, args.iterations)
+    finally:
+        server.stop(None)
+
+
+class _FakeContext(object):
+    method_name = "Echo"
+    service_url = "https://pubsub.googleapis.com/google.auth.benchmark.Echo"
+
+
+if __name__ == "__main__":
+    main()
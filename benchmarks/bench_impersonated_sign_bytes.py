@@ -0,0 +1,125 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Throughput of :meth:`google.auth.impersonated_credentials.Credentials.sign_bytes`.
+
+Signs blobs against a local stub of the IAM Credentials signBlob method, with
+a new session per signature (the old behaviour), with the persistent signing
+session, and with sign_bytes_many. Reports the number of connections opened
+per signature.
+"""
+
+import base64
+import json
+import threading
+import time
+
+from six.moves import BaseHTTPServer
+from six.moves import socketserver
+
+from google.auth import impersonated_credentials
+from google.oauth2 import credentials
+
+import _timing
+
+# The latency (in seconds) added to every signature, as a stand-in for the
+# round trip to the IAM Credentials API.
+_LATENCY = 0.002
+
+
+class _Handler(BaseHTTPServer.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    wbufsize = -1
+
+    def setup(self):
+        BaseHTTPServer.BaseHTTPRequestHandler.setup(self)
+        with self.server.lock:
+            self.server.connections += 1
+
+    def do_POST(self):
+        body = json.loads(self.rfile.read(int(self.headers["Content-Length"])))
+        time.sleep(_LATENCY)
+        payload = base64.b64decode(body["payload"])
+        signature = base64.b64encode(payload[::-1]).decode("utf-8")
+        response = json.dumps({"keyId": "1", "signedBlob": signature}).encode("utf-8")
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(response)))
+        self.end_headers()
+        self.wfile.write(response)
+
+    def log_message(self, *args):
+        pass
+
+
+class _Server(socketserver.ThreadingMixIn, BaseHTTPServer.HTTPServer):
+    daemon_threads = True
+
+    def __init__(self):
+        BaseHTTPServer.HTTPServer.__init__(self, ("127.0.0.1", 0), _Handler)
+        self.lock = threading.Lock()
+        self.connections = 0
+
+
+def main():
+    args = _timing.parse_args(__doc__, iterations=500)
+
+    server = _Server()
+    thread = threading.Thread(target=server.serve_forever)
+    thread.daemon = True
+    thread.start()
+    impersonated_credentials._IAM_SIGN_ENDPOINT = (
+        "http://127.0.0.1:{}/v1/projects/-/serviceAccounts/{{}}:signBlob".format(
+            server.server_address[1]
+        )
+    )
+
+    target = impersonated_credentials.Credentials(
+        source_credentials=credentials.Credentials(token="token"),
+        target_principal="impersonated@project.iam.gserviceaccount.com",
+        target_scopes=[],
+    )
+    message = b"x" * 256
+    batch = 50
+
+    def new_session():
+        target._signing_session = None
+        target.sign_bytes(message)
+
+    for name, func, signatures in (
+        ("sign_bytes, new session per call", new_session, 1),
+        ("sign_bytes, persistent session", lambda: target.sign_bytes(message), 1),
+        (
+            "sign_bytes_many, {} blobs".format(batch),
+            lambda: target.sign_bytes_many([message] * batch),
+            batch,
+        ),
+    ):
+        func()
+        server.connections = 0
+        iterations = max(1, args.iterations // signatures)
+        elapsed = _timing.measure(func, iterations)
+        _timing.report(name, elapsed / signatures, iterations)
+        print(
+            "  connections per signature: {:.3f}".format(
+                server.connections / float(iterations * signatures)
+            )
+        )
+
+    server.shutdown()
+    server.server_close()
+
+
+if __name__ == "__main__":
+    main()
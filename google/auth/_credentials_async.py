@@ -21,6 +21,7 @@ import inspect
 import six
 
 from google.auth import credentials
+from google.auth import instrumentation
 
 
 @six.add_metaclass(abc.ABCMeta)
@@ -63,10 +64,11 @@ class Credentials(credentials.Credentials):
         # the http request.)
 
         if not self.valid:
-            if inspect.iscoroutinefunction(self.refresh):
-                await self.refresh(request)
-            else:
-                self.refresh(request)
+            with instrumentation._refresh_span(self):
+                if inspect.iscoroutinefunction(self.refresh):
+                    await self.refresh(request)
+                else:
+                    self.refresh(request)
         self.apply(headers)
 
 
@@ -21,10 +21,12 @@ import io
 import json
 import logging
 import os
+import threading
 import warnings
 
 import six
 
+from google.auth import _exponential_backoff
 from google.auth import environment_vars
 from google.auth import exceptions
 import google.auth.transport._http_client
@@ -67,6 +69,28 @@ about service accounts, see https://cloud.google.com/docs/authentication/"""
 # The subject token type used for AWS external_account credentials.
 _AWS_SUBJECT_TOKEN_TYPE = "urn:ietf:params:aws:token-type:aws4_request"
 
+# The environment variables the environment detection depends on. Memoized
+# detection results are discarded when any of them changes.
+_DETECTION_ENVIRONMENT_VARS = (
+    environment_vars.CREDENTIALS,
+    environment_vars.CLOUD_SDK_CONFIG_DIR,
+    environment_vars.LEGACY_APPENGINE_RUNTIME,
+    environment_vars.GCE_METADATA_HOST,
+    environment_vars.GCE_METADATA_ROOT,
+    environment_vars.GCE_METADATA_IP,
+    "CLOUDSDK_ACTIVE_CONFIG_NAME",
+    "CLOUDSDK_CORE_PROJECT",
+)
+
+# How long (in seconds) an unreachable metadata server is remembered. A
+# transient failure on GCE must not stick for the lifetime of the process.
+_METADATA_UNAVAILABLE_TTL = 60
+
+# The overall time limit (in seconds) for pinging the metadata server,
+# including the retries, so that detection off GCE costs at most this long
+# rather than the per-attempt timeout times the number of attempts.
+_METADATA_PING_DEADLINE = 3
+
 
 def _warn_about_problematic_credentials(credentials):
     """Determines if the credentials are problematic.
@@ -176,6 +200,139 @@ def _load_credentials_from_info(
     return credentials, project_id
 
 
+class _MetadataPing(object):
+    """Checks whether the metadata server is available and gets the project
+    ID from it.
+
+    Args:
+        request (Optional[google.auth.transport.Request]): The transport used
+            to reach the metadata server. Defaults to the ``http.client``
+            based one.
+    """
+
+    def __init__(self, request=None):
+        self._request = request
+        self._done = threading.Event()
+        self._completed_at = None
+        self.available = False
+        self.project_id = None
+
+    def run(self):
+        """Runs the ping on the current thread."""
+        from google.auth.compute_engine import _metadata
+
+        # Ping requires a transport, but we want application default
+        # credentials to require no arguments. So, we'll use the _http_client
+        # transport which uses http.client. This is only acceptable because
+        # the metadata server doesn't do SSL and never requires proxies.
+        request = self._request
+        if request is None:
+            request = google.auth.transport._http_client.Request()
+
+        try:
+            self.available = _metadata.ping(
+                request=request, deadline=_METADATA_PING_DEADLINE
+            )
+            if self.available:
+                try:
+                    self.project_id = _metadata.get_project_id(request=request)
+                except exceptions.TransportError:
+                    self.project_id = None
+        finally:
+            self._completed_at = _exponential_backoff._monotonic()
+            self._done.set()
+
+    def wait(self):
+        """Waits for the ping to complete."""
+        self._done.wait()
+
+    @property
+    def done(self):
+        """bool: Whether the ping completed."""
+        return self._done.is_set()
+
+    @property
+    def reusable(self):
+        """bool: Whether the result can be reused by later detections."""
+        if not self._done.is_set() or self.available:
+            return True
+        elapsed = _exponential_backoff._monotonic() - self._completed_at
+        return elapsed < _METADATA_UNAVAILABLE_TTL
+
+
+class _EnvironmentDetection(object):
+    """Memoized results of the environment detection done by :func:`default`.
+
+    Args:
+        environ (Tuple[Optional[str], ...]): The values of
+            ``_DETECTION_ENVIRONMENT_VARS`` the results are valid for.
+    """
+
+    _UNSET = object()
+
+    def __init__(self, environ):
+        self.environ = environ
+        self._lock = threading.Lock()
+        self._metadata_ping = None
+        self._cloud_sdk_project_id = self._UNSET
+
+    def get_metadata_ping(self, request=None):
+        """Gets the completed metadata ping, waiting for the one another
+        thread is running or running it on the current thread when there is
+        no reusable one.
+
+        Args:
+            request (Optional[google.auth.transport.Request]): The transport
+                used when a new ping is needed.
+
+        Returns:
+            _MetadataPing: The completed ping.
+        """
+        with self._lock:
+            ping = self._metadata_ping
+            run = ping is None or not ping.reusable
+            if run:
+                ping = self._metadata_ping = _MetadataPing(request)
+        if run:
+            ping.run()
+        ping.wait()
+        return ping
+
+    def get_cloud_sdk_project_id(self):
+        """Gets the Cloud SDK project ID, running ``gcloud`` only once."""
+        from google.auth import _cloud_sdk
+
+        if self._cloud_sdk_project_id is self._UNSET:
+            self._cloud_sdk_project_id = _cloud_sdk.get_project_id()
+        return self._cloud_sdk_project_id
+
+
+_detection_lock = threading.Lock()
+_detection = None
+
+
+def _get_environment_detection():
+    """Gets the memoized environment detection results, starting afresh when
+    an environment variable they depend on has changed.
+
+    Returns:
+        _EnvironmentDetection: The detection results.
+    """
+    global _detection
+    environ = tuple(os.environ.get(name) for name in _DETECTION_ENVIRONMENT_VARS)
+    with _detection_lock:
+        if _detection is None or _detection.environ != environ:
+            _detection = _EnvironmentDetection(environ)
+        return _detection
+
+
+def _reset_environment_detection():
+    """Discards the memoized environment detection results."""
+    global _detection
+    with _detection_lock:
+        _detection = None
+
+
 def _get_gcloud_sdk_credentials(quota_project_id=None):
     """Gets the credentials and project ID from the Cloud SDK."""
     from google.auth import _cloud_sdk
@@ -194,7 +351,7 @@ def _get_gcloud_sdk_credentials(quota_project_id=None):
     )
 
     if not project_id:
-        project_id = _cloud_sdk.get_project_id()
+        project_id = _get_environment_detection().get_cloud_sdk_project_id()
 
     return credentials, project_id
 
@@ -260,32 +417,24 @@ def _get_gae_credentials():
 
 
 def _get_gce_credentials(request=None):
-    """Gets credentials and project ID from the GCE Metadata Service."""
-    # Ping requires a transport, but we want application default credentials
-    # to require no arguments. So, we'll use the _http_client transport which
-    # uses http.client. This is only acceptable because the metadata server
-    # doesn't do SSL and never requires proxies.
+    """Gets credentials and project ID from the GCE Metadata Service.
 
+    The availability of the metadata server and the project ID are memoized,
+    see :func:`_get_environment_detection`.
+    """
     # While this library is normally bundled with compute_engine, there are
     # some cases where it's not available, so we tolerate ImportError.
     try:
         from google.auth import compute_engine
-        from google.auth.compute_engine import _metadata
+        from google.auth.compute_engine import _metadata  # noqa: F401
     except ImportError:
         _LOGGER.warning("Import of Compute Engine auth library failed.")
         return None, None
 
-    if request is None:
-        request = google.auth.transport._http_client.Request()
+    ping = _get_environment_detection().get_metadata_ping(request)
 
-    if _metadata.ping(request=request):
-        # Get the project ID.
-        try:
-            project_id = _metadata.get_project_id(request=request)
-        except exceptions.TransportError:
-            project_id = None
-
-        return compute_engine.Credentials(), project_id
+    if ping.available:
+        return compute_engine.Credentials(), ping.project_id
     else:
         _LOGGER.warning(
             "Authentication failed using Compute Engine authentication due to unavailable metadata server."
@@ -513,6 +662,12 @@ def default(scopes=None, request=None, quota_project_id=None, default_scopes=Non
     5. If no credentials are found,
        :class:`~google.auth.exceptions.DefaultCredentialsError` will be raised.
 
+    The availability of the Metadata Service and the project IDs found in the
+    Cloud SDK and the Metadata Service are remembered for the lifetime of the
+    process, until one of the environment variables affecting them changes.
+    An unreachable Metadata Service is checked again after a minute. The
+    Metadata Service is only checked once the other sources are ruled out.
+
     .. _Application Default Credentials: https://developers.google.com\
             /identity/protocols/application-default-credentials
     .. _Google Cloud SDK: https://cloud.google.com/sdk
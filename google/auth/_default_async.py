@@ -171,7 +171,16 @@ def _get_gce_credentials(request=None):
     # While this library is normally bundled with compute_engine, there are
     # some cases where it's not available, so we tolerate ImportError.
 
-    return _default._get_gce_credentials(request)
+    # The environment detection is shared with the sync default (and
+    # memoized), but the credentials are refreshed with an async transport
+    # so that they don't block the event loop.
+    credentials, project_id = _default._get_gce_credentials(request)
+    if credentials is None:
+        return None, None
+
+    from google.auth.compute_engine import _credentials_async
+
+    return _credentials_async.Credentials(), project_id
 
 
 def default_async(scopes=None, request=None, quota_project_id=None):
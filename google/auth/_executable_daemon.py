@@ -0,0 +1,257 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Long-lived executables answering pluggable credential requests.
+
+Rather than running an executable on every refresh, an
+:class:`ExecutableDaemon` starts it once and keeps it running. Requests and
+responses are JSON objects, one per line: each request is written to the
+standard input of the executable, which writes its response to its standard
+output. Responses have the same format as the output of executables run once.
+The standard error of the executable is kept for error messages.
+
+An executable that exits is started again on the next request. A request
+interrupted by the exit is retried once on the new process. An executable
+that doesn't respond in time is killed, since its responses can no longer
+be matched with the requests.
+"""
+
+import atexit
+import collections
+import json
+import logging
+import subprocess
+import threading
+
+from six.moves import queue
+
+from google.auth import exceptions
+
+_LOGGER = logging.getLogger(__name__)
+
+# The number of lines of standard error kept for error messages.
+_STDERR_LINES = 20
+
+# Put on the response queue when the standard output of the process closes.
+_EOF = object()
+
+
+class _ProcessExited(Exception):
+    """The process exited before responding."""
+
+
+class ExecutableDaemon(object):
+    """Supervises a long-lived executable and sends it requests.
+
+    Daemons are thread-safe; requests are sent one at a time. Use
+    :func:`get_daemon` to share the daemon of an executable across the
+    process.
+
+    Args:
+        args (Sequence[str]): The command line of the executable.
+        env (Mapping[str, str]): The environment of the executable.
+    """
+
+    def __init__(self, args, env):
+        self.args = list(args)
+        self._env = dict(env)
+        self._lock = threading.Lock()
+        self._process = None
+        self._responses = None
+        self._stderr = collections.deque(maxlen=_STDERR_LINES)
+        self._stderr_thread = None
+
+    def request(self, message, timeout):
+        """Sends a request and waits for its response.
+
+        Args:
+            message (Mapping[str, Any]): The request.
+            timeout (float): The number of seconds to wait for the response,
+                including the time taken to start the executable.
+
+        Returns:
+            Mapping[str, Any]: The response.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If the executable can't be
+                started, exits twice, doesn't respond in time or doesn't
+                respond with JSON.
+        """
+        line = json.dumps(message) + "\n"
+        with self._lock:
+            try:
+                return self._send(line, timeout)
+            except _ProcessExited:
+                _LOGGER.debug("Restarting executable %s", self.args[0])
+            try:
+                return self._send(line, timeout)
+            except _ProcessExited:
+                process, self._process = self._process, None
+                raise exceptions.RefreshError(
+                    "Executable exited with return code {}. Error: {}".format(
+                        process.wait(), "".join(self._stderr)
+                    )
+                )
+
+    def _send(self, line, timeout):
+        if self._process is None or self._process.poll() is not None:
+            self._start()
+        try:
+            self._process.stdin.write(line)
+            self._process.stdin.flush()
+        except (IOError, OSError):
+            raise _ProcessExited()
+
+        try:
+            response = self._responses.get(timeout=timeout)
+        except queue.Empty:
+            self._stop()
+            raise exceptions.RefreshError(
+                "Executable did not respond within {} seconds.".format(timeout)
+            )
+        if response is _EOF:
+            self._process.wait()
+            self._stderr_thread.join(1)
+            raise _ProcessExited()
+        try:
+            return json.loads(response)
+        except ValueError:
+            self._stop()
+            raise exceptions.RefreshError(
+                "Executable responded with invalid JSON: {}".format(response)
+            )
+
+    def _start(self):
+        self._stderr.clear()
+        try:
+            process = subprocess.Popen(
+                self.args,
+                stdin=subprocess.PIPE,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.PIPE,
+                env=self._env,
+                universal_newlines=True,
+                bufsize=1,
+            )
+        except (IOError, OSError) as caught_exc:
+            raise exceptions.RefreshError(
+                "Unable to start executable: {}".format(caught_exc)
+            )
+        # Each process gets its own queue, so that the output of a process
+        # that was stopped can't be taken for a response.
+        self._responses = queue.Queue()
+        self._process = process
+        for target, stream in (
+            (self._read_stdout, process.stdout),
+            (self._read_stderr, process.stderr),
+        ):
+            thread = threading.Thread(
+                target=target,
+                args=(stream, self._responses),
+                name="google-auth-executable-daemon",
+            )
+            thread.daemon = True
+            thread.start()
+        self._stderr_thread = thread
+
+    @staticmethod
+    def _read_stdout(stream, responses):
+        for line in iter(stream.readline, ""):
+            if line.strip():
+                responses.put(line)
+        responses.put(_EOF)
+
+    def _read_stderr(self, stream, _):
+        for line in iter(stream.readline, ""):
+            self._stderr.append(line)
+
+    def _stop(self):
+        process, self._process = self._process, None
+        if process is None:
+            return
+        if process.poll() is None:
+            process.kill()
+        process.wait()
+        try:
+            process.stdin.close()
+        except (IOError, OSError):
+            pass
+
+    def close(self):
+        """Stops the executable, if it is running."""
+        with self._lock:
+            process, self._process = self._process, None
+        if process is None:
+            return
+        # Closing its standard input asks the executable to exit.
+        try:
+            process.stdin.close()
+        except (IOError, OSError):
+            pass
+        try:
+            process.wait(timeout=1)
+        except subprocess.TimeoutExpired:
+            process.kill()
+            process.wait()
+
+
+_daemons_lock = threading.Lock()
+_daemons = {}
+
+
+# The prefix of the environment variables describing the token requested
+# from the executable. Daemons are shared by the credentials with the same
+# command line and values of these variables.
+_ENVIRONMENT_VARS_PREFIX = "GOOGLE_EXTERNAL_ACCOUNT_"
+
+
+def get_daemon(args, env):
+    """Returns the process-wide daemon of an executable.
+
+    Daemons are identified by the command line and the
+    ``GOOGLE_EXTERNAL_ACCOUNT_*`` variables of the environment, so changes to
+    other variables don't start another daemon. A daemon keeps the environment
+    it was first started with.
+
+    Args:
+        args (Sequence[str]): The command line of the executable.
+        env (Mapping[str, str]): The environment of the executable.
+
+    Returns:
+        ExecutableDaemon: The daemon.
+    """
+    key = (
+        tuple(args),
+        tuple(
+            sorted(
+                (name, value)
+                for name, value in env.items()
+                if name.startswith(_ENVIRONMENT_VARS_PREFIX)
+            )
+        ),
+    )
+    with _daemons_lock:
+        daemon = _daemons.get(key)
+        if daemon is None:
+            daemon = _daemons[key] = ExecutableDaemon(args, env)
+        return daemon
+
+
+@atexit.register
+def _close_all():
+    with _daemons_lock:
+        daemons = list(_daemons.values())
+        _daemons.clear()
+    for daemon in daemons:
+        daemon.close()
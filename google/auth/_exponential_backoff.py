@@ -0,0 +1,183 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Exponential backoff with full jitter for retried requests.
+
+Iterating over an :class:`ExponentialBackoff` yields the attempt numbers,
+sleeping before every attempt but the first::
+
+    backoff = ExponentialBackoff(total_attempts=5, deadline=10)
+    for attempt in backoff:
+        response = request(url, timeout=backoff.remaining())
+        if response.status not in RETRYABLE_STATUS_CODES:
+            break
+
+The delay before attempt ``n + 1`` is drawn uniformly between zero and
+``min(max_delay, initial_delay * multiplier ** (n - 1))``, so that clients
+failing at the same time don't retry at the same time. See
+https://aws.amazon.com/blogs/architecture/exponential-backoff-and-jitter/.
+"""
+
+import email.utils
+import random
+import time
+
+from google.auth import instrumentation
+
+_DEFAULT_INITIAL_DELAY = 1.0
+_DEFAULT_MAX_DELAY = 60.0
+_DEFAULT_MULTIPLIER = 2.0
+
+# The deadline is measured on a clock that doesn't jump with the wall clock.
+try:
+    _monotonic = time.monotonic
+except AttributeError:  # pragma: NO COVER
+    # Python 2
+    _monotonic = time.time
+
+
+def parse_retry_after(value):
+    """Parses the value of a ``Retry-After`` header.
+
+    Args:
+        value (Optional[str]): The header value, either a number of seconds
+            or an HTTP date.
+
+    Returns:
+        Optional[float]: The number of seconds to wait, or None if the value
+            is missing or invalid.
+    """
+    if not value:
+        return None
+    try:
+        return max(0.0, float(value))
+    except ValueError:
+        parsed = email.utils.parsedate_tz(value)
+        if parsed is None:
+            return None
+        return max(0.0, email.utils.mktime_tz(parsed) - time.time())
+
+
+class ExponentialBackoff(object):
+    """Attempts separated by exponentially growing, jittered delays.
+
+    Args:
+        total_attempts (int): The maximum number of attempts.
+        initial_delay (float): The upper bound of the first delay, in
+            seconds.
+        max_delay (float): The upper bound of every delay, in seconds.
+        multiplier (float): How much the upper bound grows after each
+            attempt.
+        deadline (Optional[float]): The number of seconds, counted from the
+            start of the iteration, after which no more attempts are made.
+        span_name (Optional[str]): The operation name reported to
+            :mod:`google.auth.instrumentation` for each delay.
+    """
+
+    def __init__(
+        self,
+        total_attempts=3,
+        initial_delay=_DEFAULT_INITIAL_DELAY,
+        max_delay=_DEFAULT_MAX_DELAY,
+        multiplier=_DEFAULT_MULTIPLIER,
+        deadline=None,
+        span_name=None,
+    ):
+        self.total_attempts = total_attempts
+        self._initial_delay = initial_delay
+        self._max_delay = max_delay
+        self._multiplier = multiplier
+        self._deadline = deadline
+        self._span_name = span_name
+        self._attempt = 0
+        self._start = None
+        self._retry_after = None
+
+    @property
+    def attempt(self):
+        """int: The number of attempts made so far."""
+        return self._attempt
+
+    def remaining(self):
+        """Returns the time left before the deadline.
+
+        Returns:
+            Optional[float]: The number of seconds left, or None if there is
+                no deadline.
+        """
+        if self._deadline is None:
+            return None
+        return max(0.0, self._deadline - (_monotonic() - self._start))
+
+    def retry_after(self, delay):
+        """Sets the minimum delay before the next attempt, for example from a
+        ``Retry-After`` header.
+
+        The delay is capped at ``max_delay``, so that a server can't stall the
+        retries for longer than that.
+
+        Args:
+            delay (Optional[float]): The minimum delay in seconds, or None.
+        """
+        self._retry_after = delay
+
+    def __iter__(self):
+        self._attempt = 0
+        self._start = _monotonic()
+        self._retry_after = None
+        return self
+
+    def _next_delay(self):
+        """Returns how long to wait before the next attempt.
+
+        Raises:
+            StopIteration: If no attempt is left before the deadline.
+        """
+        if self._attempt >= self.total_attempts:
+            raise StopIteration
+
+        if self._attempt == 0:
+            return 0
+
+        delay = random.uniform(
+            0,
+            min(
+                self._max_delay,
+                self._initial_delay * self._multiplier ** (self._attempt - 1),
+            ),
+        )
+        if self._retry_after is not None:
+            delay = max(delay, min(self._retry_after, self._max_delay))
+            self._retry_after = None
+
+        remaining = self.remaining()
+        if remaining is not None and delay >= remaining:
+            raise StopIteration
+        return delay
+
+    def _delay_span(self):
+        if self._span_name is None:
+            return instrumentation._NO_OP_SPAN
+        return instrumentation._span(self._span_name, attempt=str(self._attempt + 1))
+
+    def __next__(self):
+        delay = self._next_delay()
+        if self._attempt > 0:
+            with self._delay_span():
+                time.sleep(delay)
+
+        self._attempt += 1
+        return self._attempt
+
+    next = __next__  # Python 2
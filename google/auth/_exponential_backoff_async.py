@@ -0,0 +1,57 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Exponential backoff with full jitter for retried asynchronous requests.
+
+This is :class:`google.auth._exponential_backoff.ExponentialBackoff` iterated
+with ``async for``, waiting on the event loop instead of blocking it::
+
+    backoff = AsyncExponentialBackoff(total_attempts=5, deadline=10)
+    async for attempt in backoff:
+        response = await request(url, timeout=backoff.remaining())
+        if response.status not in RETRYABLE_STATUS_CODES:
+            break
+"""
+
+import asyncio
+
+from google.auth import _exponential_backoff
+
+
+class AsyncExponentialBackoff(_exponential_backoff.ExponentialBackoff):
+    """Attempts separated by exponentially growing, jittered delays, awaited
+    without blocking the event loop.
+
+    The arguments are those of
+    :class:`google.auth._exponential_backoff.ExponentialBackoff`.
+    """
+
+    def __aiter__(self):
+        self._attempt = 0
+        self._start = _exponential_backoff._monotonic()
+        self._retry_after = None
+        return self
+
+    async def __anext__(self):
+        try:
+            delay = self._next_delay()
+        except StopIteration:
+            raise StopAsyncIteration
+
+        if self._attempt > 0:
+            with self._delay_span():
+                await asyncio.sleep(delay)
+
+        self._attempt += 1
+        return self._attempt
@@ -0,0 +1,125 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Advisory file locks shared by the processes of a host, and atomic file
+writes.
+
+A :class:`FileLock` is held by at most one process, or one thread, at a time.
+It is advisory: only the code taking the lock is excluded, and the locked file
+can still be read and written. Locks are released when the process holding
+them exits, so a process that crashes doesn't leave them held.
+"""
+
+import io
+import os
+import tempfile
+import time
+
+try:
+    import fcntl
+except ImportError:  # pragma: NO COVER
+    fcntl = None
+    import msvcrt
+
+# How often (in seconds) a held lock is tried again.
+_POLL_INTERVAL = 0.05
+
+
+class FileLock(object):
+    """An exclusive lock on a file, created if missing.
+
+    Args:
+        path (str): The path of the lock file.
+    """
+
+    def __init__(self, path):
+        self.path = path
+        self._fd = None
+
+    def acquire(self, timeout):
+        """Waits for the lock.
+
+        Args:
+            timeout (float): The number of seconds to wait for the lock.
+
+        Returns:
+            bool: Whether the lock was acquired.
+
+        Raises:
+            OSError: If the lock file can't be opened.
+        """
+        fd = os.open(self.path, os.O_RDWR | os.O_CREAT, 0o600)
+        deadline = time.time() + timeout
+        while True:
+            try:
+                _lock(fd)
+            except (IOError, OSError):
+                if time.time() >= deadline:
+                    os.close(fd)
+                    return False
+                time.sleep(_POLL_INTERVAL)
+            else:
+                self._fd = fd
+                return True
+
+    def release(self):
+        """Releases the lock, if it is held."""
+        fd, self._fd = self._fd, None
+        if fd is not None:
+            _unlock(fd)
+            os.close(fd)
+
+
+if fcntl is not None:
+
+    def _lock(fd):
+        fcntl.flock(fd, fcntl.LOCK_EX | fcntl.LOCK_NB)
+
+    def _unlock(fd):
+        fcntl.flock(fd, fcntl.LOCK_UN)
+
+
+else:  # pragma: NO COVER
+
+    def _lock(fd):
+        os.lseek(fd, 0, os.SEEK_SET)
+        msvcrt.locking(fd, msvcrt.LK_NBLCK, 1)
+
+    def _unlock(fd):
+        os.lseek(fd, 0, os.SEEK_SET)
+        msvcrt.locking(fd, msvcrt.LK_UNLCK, 1)
+
+
+def write_atomically(path, content):
+    """Replaces the content of a file, so that readers see either the old or
+    the new content in full.
+
+    Args:
+        path (str): The path of the file.
+        content (str): The new content.
+
+    Raises:
+        OSError: If the file can't be written.
+    """
+    directory, name = os.path.split(os.path.abspath(path))
+    fd, temp_path = tempfile.mkstemp(dir=directory, prefix="." + name + ".")
+    try:
+        with io.open(fd, "w", encoding="utf-8") as file_obj:
+            file_obj.write(content)
+        # Python 2 has no os.replace, but os.rename also replaces existing
+        # files, except on Windows.
+        getattr(os, "replace", os.rename)(temp_path, path)
+    except BaseException:
+        os.remove(temp_path)
+        raise
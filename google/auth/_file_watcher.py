@@ -0,0 +1,353 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Reads files that change rarely, such as rotated credential files.
+
+A :class:`FileWatcher` keeps the content of a file in memory and only reads
+it again when the file changes. Changes are detected by comparing the status
+of the file, so a read of an unchanged file costs a single ``stat``.
+
+Subscribing to a watcher starts a background thread that calls back when the
+content changes. On Linux, the thread is notified of the changes with
+inotify, and while it is, reads of the file cost no system call at all.
+Elsewhere, the thread polls the status of the file.
+
+The directory of the file is watched rather than the file itself, so that
+files replaced by a rename or by swapping a symlink, like the Kubernetes
+projected volumes do, are followed. When a watched directory goes away, as
+the previous target of a swapped symlink does, the watch is set up again on
+the current target.
+"""
+
+import ctypes
+import ctypes.util
+import errno
+import io
+import logging
+import os
+import select
+import struct
+import sys
+import threading
+
+_LOGGER = logging.getLogger(__name__)
+
+# How often (in seconds) the status of a watched file is checked when inotify
+# is not available.
+_DEFAULT_POLL_INTERVAL = 10
+
+
+def _signature(path):
+    """Returns what identifies a version of the file: a new file, a rename or
+    a write each change it."""
+    stat = os.stat(path)
+    return (
+        stat.st_dev,
+        stat.st_ino,
+        stat.st_size,
+        getattr(stat, "st_mtime_ns", stat.st_mtime),
+        getattr(stat, "st_ctime_ns", stat.st_ctime),
+    )
+
+
+class _Inotify(object):
+    """A minimal inotify binding, watching directories for any change to
+    their entries."""
+
+    _IN_ATTRIB = 0x4
+    _IN_CLOSE_WRITE = 0x8
+    _IN_MOVED_FROM = 0x40
+    _IN_MOVED_TO = 0x80
+    _IN_CREATE = 0x100
+    _IN_DELETE = 0x200
+    _IN_DELETE_SELF = 0x400
+    _IN_MOVE_SELF = 0x800
+    _IN_Q_OVERFLOW = 0x4000
+    _IN_IGNORED = 0x8000
+    _IN_CLOEXEC = 0o2000000
+
+    # Writes in place are reported once the file is closed, rather than on
+    # each write, so that partially written files are not read.
+    _MASK = (
+        _IN_ATTRIB
+        | _IN_CLOSE_WRITE
+        | _IN_MOVED_FROM
+        | _IN_MOVED_TO
+        | _IN_CREATE
+        | _IN_DELETE
+        | _IN_DELETE_SELF
+        | _IN_MOVE_SELF
+    )
+    _EVENT = struct.Struct("iIII")
+
+    def __init__(self, fd):
+        self.fd = fd
+
+    @classmethod
+    def create(cls, directories):
+        """Starts watching directories.
+
+        Args:
+            directories (Sequence[str]): The directories to watch.
+
+        Returns:
+            Optional[_Inotify]: The watch, or None if inotify is not
+                available.
+        """
+        if not sys.platform.startswith("linux"):
+            return None
+        try:
+            libc = ctypes.CDLL(ctypes.util.find_library("c"), use_errno=True)
+            inotify_init1 = libc.inotify_init1
+            inotify_add_watch = libc.inotify_add_watch
+        except (OSError, AttributeError):
+            return None
+
+        fd = inotify_init1(os.O_NONBLOCK | cls._IN_CLOEXEC)
+        if fd < 0:
+            return None
+        for directory in directories:
+            path = directory.encode(sys.getfilesystemencoding())
+            if inotify_add_watch(fd, path, cls._MASK) < 0:
+                _LOGGER.debug(
+                    "Unable to watch %s with inotify: %s",
+                    directory,
+                    os.strerror(ctypes.get_errno()),
+                )
+                os.close(fd)
+                return None
+        return cls(fd)
+
+    def read_events(self):
+        """Reads the pending events.
+
+        Returns:
+            bool: False if the watch must be set up again, because a
+                directory was removed or events were lost.
+        """
+        mask = 0
+        while True:
+            try:
+                data = os.read(self.fd, 4096)
+            except (IOError, OSError) as caught_exc:
+                if caught_exc.errno == errno.EAGAIN:
+                    break
+                raise
+            offset = 0
+            while offset < len(data):
+                _, event_mask, _, length = self._EVENT.unpack_from(data, offset)
+                mask |= event_mask
+                offset += self._EVENT.size + length
+        return not mask & (self._IN_IGNORED | self._IN_Q_OVERFLOW)
+
+    def close(self):
+        os.close(self.fd)
+
+
+class FileWatcher(object):
+    """Reads a file, keeping its content until it changes.
+
+    Watchers are thread-safe. Use :func:`get_watcher` to share the watcher of
+    a file across the process.
+
+    Args:
+        path (str): The path of the file.
+        poll_interval (float): How often (in seconds) subscribers poll the
+            status of the file when inotify is not available.
+    """
+
+    def __init__(self, path, poll_interval=_DEFAULT_POLL_INTERVAL):
+        self.path = path
+        self._poll_interval = poll_interval
+        self._lock = threading.Lock()
+        self._signature = None
+        self._content = None
+        # Whether inotify is reporting the changes, so that the cached content
+        # is known to be current without checking the file.
+        self._current = False
+        self._callbacks = []
+        self._thread = None
+        self._closed = threading.Event()
+        self._wake_read, self._wake_write = None, None
+
+    def read(self):
+        """Returns the content of the file, reading it only if it changed
+        since the last read.
+
+        Returns:
+            str: The content of the file.
+
+        Raises:
+            OSError: If the file can't be read.
+        """
+        if self._current:
+            return self._content
+        with self._lock:
+            return self._load()
+
+    def _load(self):
+        signature = _signature(self.path)
+        if signature != self._signature:
+            with io.open(self.path, "r", encoding="utf-8") as file_obj:
+                self._content = file_obj.read()
+            self._signature = signature
+        return self._content
+
+    def subscribe(self, callback):
+        """Calls back when the content of the file changes.
+
+        The first subscription starts the background thread watching the file.
+        Changes are reported from the content of the file at that time.
+
+        Args:
+            callback (Callable[[str], None]): Called with the new content of
+                the file, on the background thread.
+        """
+        with self._lock:
+            self._callbacks.append(callback)
+            if self._thread is None:
+                try:
+                    content = self._load()
+                except (IOError, OSError):
+                    content = None
+                self._wake_read, self._wake_write = os.pipe()
+                self._thread = threading.Thread(
+                    target=self._run,
+                    args=(content,),
+                    name="google-auth-file-watcher",
+                )
+                self._thread.daemon = True
+                self._thread.start()
+
+    def unsubscribe(self, callback):
+        """Stops calling back a subscribed callback.
+
+        Args:
+            callback (Callable[[str], None]): The callback.
+        """
+        with self._lock:
+            if callback in self._callbacks:
+                self._callbacks.remove(callback)
+
+    def close(self):
+        """Stops the background thread, if any."""
+        self._closed.set()
+        with self._lock:
+            thread, self._thread = self._thread, None
+        if thread is not None:
+            os.write(self._wake_write, b"x")
+            thread.join()
+            os.close(self._wake_read)
+            os.close(self._wake_write)
+
+    def _check(self, content):
+        """Loads the file and calls back if its content is not ``content``.
+
+        Returns:
+            Tuple[Optional[str], bool]: The content of the file, or
+                ``content`` if it couldn't be read, and whether it could.
+        """
+        try:
+            with self._lock:
+                new_content = self._load()
+        except (IOError, OSError) as caught_exc:
+            # The file may be briefly missing while it is being replaced.
+            _LOGGER.debug("Unable to read %s: %s", self.path, caught_exc)
+            return content, False
+
+        if new_content != content:
+            with self._lock:
+                callbacks = list(self._callbacks)
+            for callback in callbacks:
+                try:
+                    callback(new_content)
+                except Exception:  # pylint: disable=broad-except
+                    _LOGGER.exception("File watch callback for %s failed", self.path)
+        return new_content, True
+
+    def _watch(self):
+        """Watches the directory of the file and the directory it currently
+        resolves to.
+
+        Returns:
+            Optional[_Inotify]: The watch, or None if inotify is not
+                available.
+        """
+        directories = [os.path.dirname(os.path.abspath(self.path))]
+        target = os.path.dirname(os.path.realpath(self.path))
+        if target not in directories:
+            directories.append(target)
+        return _Inotify.create(directories)
+
+    def _run(self, content):
+        inotify = self._watch()
+        # Whether inotify worked, so that it is tried again after falling
+        # back to polling, for example while a symlink target is missing.
+        rewatch = inotify is not None
+
+        # Report the changes made before the watch started.
+        content, loaded = self._check(content)
+
+        try:
+            while not self._closed.is_set():
+                if inotify is None:
+                    self._closed.wait(self._poll_interval)
+                    if self._closed.is_set():
+                        break
+                    if rewatch:
+                        inotify = self._watch()
+                    content, loaded = self._check(content)
+                    continue
+
+                # Changes made since the file was loaded are pending events,
+                # so the content is current until they are read.
+                self._current = loaded
+                select.select([inotify.fd, self._wake_read], [], [])
+                if self._closed.is_set():
+                    break
+                self._current = False
+                if not inotify.read_events():
+                    inotify.close()
+                    # Set up before checking the file, so that no change made
+                    # in between is missed.
+                    inotify = self._watch()
+                    if inotify is None:
+                        _LOGGER.debug(
+                            "Polling %s until it can be watched again", self.path
+                        )
+                content, loaded = self._check(content)
+        finally:
+            self._current = False
+            if inotify is not None:
+                inotify.close()
+
+
+_watchers_lock = threading.Lock()
+_watchers = {}
+
+
+def get_watcher(path):
+    """Returns the process-wide watcher of a file.
+
+    Args:
+        path (str): The path of the file.
+
+    Returns:
+        FileWatcher: The watcher.
+    """
+    with _watchers_lock:
+        watcher = _watchers.get(path)
+        if watcher is None:
+            watcher = _watchers[path] = FileWatcher(path)
+        return watcher
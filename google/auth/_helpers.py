@@ -18,8 +18,10 @@ import base64
 import calendar
 import datetime
 import sys
+import threading
 
 import six
+from six.moves import queue
 from six.moves import urllib
 
 
@@ -29,6 +31,11 @@ from six.moves import urllib
 # until 30 seconds before the expiration, and cause a spike of CPU usage.
 REFRESH_THRESHOLD = datetime.timedelta(seconds=20)
 
+# The default number of concurrent requests made by map_concurrently callers.
+# It matches the default size of the connection pools of requests and urllib3,
+# so that every request can reuse a pooled connection.
+DEFAULT_MAX_CONCURRENCY = 10
+
 
 def copy_docstring(source_class):
     """Decorator that copies a method's docstring from another class.
@@ -243,3 +250,76 @@ def is_python_3():
         bool: True if the Python interpreter is Python 3 and False otherwise.
     """
     return sys.version_info > (3, 0)
+
+
+def check_max_concurrency(max_concurrency):
+    """Checks a maximum number of concurrent calls.
+
+    Args:
+        max_concurrency (int): The maximum number of concurrent calls.
+
+    Raises:
+        ValueError: If it is less than one.
+    """
+    if max_concurrency < 1:
+        raise ValueError(
+            "max_concurrency must be at least 1, got {}.".format(max_concurrency)
+        )
+
+
+def map_concurrently(func, items, max_concurrency, thread_name, first_serially=False):
+    """Calls a function on each item, with a bounded number of worker threads.
+
+    Args:
+        func (Callable[[Any], Any]): The function to call.
+        items (Sequence[Any]): The items to call it on.
+        max_concurrency (int): The maximum number of calls in flight.
+        thread_name (str): The name of the worker threads.
+        first_serially (bool): Whether to call the function on the first item
+            before starting the workers, so that state shared by all the
+            calls, such as a token, is set up by a single call.
+
+    Returns:
+        Sequence[Any]: The result of each call, in the order of the items.
+
+    Raises:
+        ValueError: If ``max_concurrency`` is less than one.
+        Exception: The first error raised by ``func``. No call is started
+            after an error, and the calls in flight are waited for.
+    """
+    check_max_concurrency(max_concurrency)
+    items = list(items)
+    results = [None] * len(items)
+    start = 0
+    if first_serially and items:
+        results[0] = func(items[0])
+        start = 1
+
+    errors = []
+    pending = queue.Queue()
+    for index in range(start, len(items)):
+        pending.put(index)
+
+    def work():
+        while not errors:
+            try:
+                index = pending.get_nowait()
+            except queue.Empty:
+                return
+            try:
+                results[index] = func(items[index])
+            except Exception as caught_exc:  # pylint: disable=broad-except
+                errors.append(caught_exc)
+
+    workers = [
+        threading.Thread(target=work, name=thread_name)
+        for _ in range(min(max_concurrency, len(items) - start))
+    ]
+    for worker in workers:
+        worker.daemon = True
+        worker.start()
+    for worker in workers:
+        worker.join()
+    if errors:
+        raise errors[0]
+    return results
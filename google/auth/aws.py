@@ -37,10 +37,12 @@ via the GCP STS endpoint.
 .. _AWS STS GetCallerIdentity: https://docs.aws.amazon.com/STS/latest/APIReference/API_GetCallerIdentity.html
 """
 
+import datetime
 import hashlib
 import hmac
 import io
 import json
+import logging
 import os
 import posixpath
 import re
@@ -54,6 +56,8 @@ from google.auth import environment_vars
 from google.auth import exceptions
 from google.auth import external_account
 
+_LOGGER = logging.getLogger(__name__)
+
 # AWS Signature Version 4 signing algorithm identifier.
 _AWS_ALGORITHM = "AWS4-HMAC-SHA256"
 # The termination string for the AWS credential scope value as defined in
@@ -63,12 +67,28 @@ _AWS_REQUEST_TYPE = "aws4_request"
 _AWS_SECURITY_TOKEN_HEADER = "x-amz-security-token"
 # The AWS authorization header name for the auto-generated date.
 _AWS_DATE_HEADER = "x-amz-date"
+# The lifetime of the requested IMDSv2 session tokens, in seconds.
+_IMDSV2_SESSION_TOKEN_TTL = 300
+# How long before expiring cached IMDSv2 session tokens are replaced.
+_IMDSV2_SESSION_TOKEN_REFRESH_THRESHOLD = datetime.timedelta(seconds=30)
+# How long before expiring the AWS security credentials of the metadata server
+# are retrieved again. The metadata server makes new credentials available at
+# least 5 minutes before the current ones expire.
+_AWS_SECURITY_CREDENTIALS_REFRESH_AHEAD = datetime.timedelta(minutes=5)
+# The SHA-256 hash of an empty request payload.
+_EMPTY_PAYLOAD_HASH = hashlib.sha256(b"").hexdigest()
+# The maximum number of URLs whose canonical components a RequestSigner keeps.
+_MAX_CACHED_URLS = 128
 
 
 class RequestSigner(object):
     """Implements an AWS request signer based on the AWS Signature Version 4 signing
     process.
     https://docs.aws.amazon.com/general/latest/gr/signature-version-4.html
+
+    The signer caches the signing keys it derives, for the day they are valid,
+    and the canonical components of the URLs it signs, so reusing a signer for
+    many requests is cheaper than creating new ones.
     """
 
     def __init__(self, region_name):
@@ -80,6 +100,41 @@ class RequestSigner(object):
         """
 
         self._region_name = region_name
+        self._signing_keys = _SigningKeyCache()
+        # The host, canonical URI and canonical query string of each URL.
+        self._url_components = {}
+
+    def _get_url_components(self, url):
+        """Returns the host, canonical URI and canonical query string of a
+        URL, computing them on first use.
+
+        Raises:
+            ValueError: If the URL is not a valid AWS service URL.
+        """
+        components = self._url_components.get(url)
+        if components is not None:
+            return components
+
+        uri = urllib.parse.urlparse(url)
+        # Normalize the URL path. This is needed for the canonical_uri.
+        # os.path.normpath can't be used since it normalizes "/" paths
+        # to "\\" in Windows OS.
+        normalized_uri = urllib.parse.urlparse(
+            urljoin(url, posixpath.normpath(uri.path))
+        )
+        # Validate provided URL.
+        if not uri.hostname or uri.scheme != "https":
+            raise ValueError("Invalid AWS service URL")
+
+        components = (
+            uri.hostname,
+            normalized_uri.path or "/",
+            _get_canonical_querystring(uri.query),
+        )
+        if len(self._url_components) >= _MAX_CACHED_URLS:
+            self._url_components = {}
+        self._url_components[url] = components
+        return components
 
     def get_request_options(
         self,
@@ -114,21 +169,12 @@ class RequestSigner(object):
 
         additional_headers = additional_headers or {}
 
-        uri = urllib.parse.urlparse(url)
-        # Normalize the URL path. This is needed for the canonical_uri.
-        # os.path.normpath can't be used since it normalizes "/" paths
-        # to "\\" in Windows OS.
-        normalized_uri = urllib.parse.urlparse(
-            urljoin(url, posixpath.normpath(uri.path))
-        )
-        # Validate provided URL.
-        if not uri.hostname or uri.scheme != "https":
-            raise ValueError("Invalid AWS service URL")
+        host, canonical_uri, canonical_querystring = self._get_url_components(url)
 
         header_map = _generate_authentication_header_map(
-            host=uri.hostname,
-            canonical_uri=normalized_uri.path or "/",
-            canonical_querystring=_get_canonical_querystring(uri.query),
+            host=host,
+            canonical_uri=canonical_uri,
+            canonical_querystring=canonical_querystring,
             method=method,
             region=self._region_name,
             access_key=access_key,
@@ -136,10 +182,11 @@ class RequestSigner(object):
             security_token=security_token,
             request_payload=request_payload,
             additional_headers=additional_headers,
+            signing_keys=self._signing_keys,
         )
         headers = {
             "Authorization": header_map.get("authorization_header"),
-            "host": uri.hostname,
+            "host": host,
         }
         # Add x-amz-date if available.
         if "amz_date" in header_map:
@@ -229,6 +276,45 @@ def _get_signing_key(key, date_stamp, region_name, service_name):
     return k_signing
 
 
+class _SigningKeyCache(object):
+    """Caches the signing keys derived by :func:`_get_signing_key`.
+
+    A signing key is only valid on the date it was derived for, so the keys
+    of earlier dates are dropped when the date changes.
+    """
+
+    def __init__(self):
+        self._date_stamp = None
+        self._keys = {}
+
+    def get(self, key, date_stamp, region_name, service_name):
+        """Returns the signing key, deriving it on first use.
+
+        Args:
+            key (str): The AWS secret access key.
+            date_stamp (str): The '%Y%m%d' date format.
+            region_name (str): The AWS region.
+            service_name (str): The AWS service name, eg. sts.
+
+        Returns:
+            str: The signing key bytes.
+        """
+        keys = self._keys
+        if date_stamp != self._date_stamp:
+            keys = {}
+            self._keys = keys
+            self._date_stamp = date_stamp
+
+        # The date is part of the cache key too, so that a key derived while
+        # another thread changes the date is never used for the wrong date.
+        cache_key = (key, date_stamp, region_name, service_name)
+        signing_key = keys.get(cache_key)
+        if signing_key is None:
+            signing_key = _get_signing_key(key, date_stamp, region_name, service_name)
+            keys[cache_key] = signing_key
+        return signing_key
+
+
 def _generate_authentication_header_map(
     host,
     canonical_uri,
@@ -240,6 +326,7 @@ def _generate_authentication_header_map(
     security_token,
     request_payload="",
     additional_headers={},
+    signing_keys=None,
 ):
     """Generates the authentication header map needed for generating the AWS
     Signature Version 4 signed request.
@@ -258,6 +345,8 @@ def _generate_authentication_header_map(
             available.
         additional_headers (Optional[Mapping[str, str]]): The optional
             additional headers needed for the requested AWS API.
+        signing_keys (Optional[_SigningKeyCache]): The cache of the signing
+            keys. If not provided, the signing key is derived every time.
 
     Returns:
         Mapping[str, str]: The AWS authentication header dictionary object.
@@ -298,7 +387,10 @@ def _generate_authentication_header_map(
         )
     signed_headers = ";".join(header_keys)
 
-    payload_hash = hashlib.sha256((request_payload or "").encode("utf-8")).hexdigest()
+    if request_payload:
+        payload_hash = hashlib.sha256(request_payload.encode("utf-8")).hexdigest()
+    else:
+        payload_hash = _EMPTY_PAYLOAD_HASH
 
     # https://docs.aws.amazon.com/general/latest/gr/sigv4-create-canonical-request.html
     canonical_request = "{}\n{}\n{}\n{}\n{}\n{}".format(
@@ -323,7 +415,10 @@ def _generate_authentication_header_map(
     )
 
     # https://docs.aws.amazon.com/general/latest/gr/sigv4-calculate-signature.html
-    signing_key = _get_signing_key(secret_key, date_stamp, region, service_name)
+    if signing_keys is None:
+        signing_key = _get_signing_key(secret_key, date_stamp, region, service_name)
+    else:
+        signing_key = signing_keys.get(secret_key, date_stamp, region, service_name)
     signature = hmac.new(
         signing_key, string_to_sign.encode("utf-8"), hashlib.sha256
     ).hexdigest()
@@ -340,6 +435,53 @@ def _generate_authentication_header_map(
     return authentication_header
 
 
+def _get_env_region():
+    """Returns the AWS region from the AWS_REGION or AWS_DEFAULT_REGION
+    environment variable, or None if neither is set."""
+    env_aws_region = os.environ.get(environment_vars.AWS_REGION)
+    if env_aws_region is not None:
+        return env_aws_region
+    return os.environ.get(environment_vars.AWS_DEFAULT_REGION)
+
+
+def _get_env_security_credentials():
+    """Returns the AWS security credentials from the environment variables,
+    or None if they are not set."""
+    env_aws_access_key_id = os.environ.get(environment_vars.AWS_ACCESS_KEY_ID)
+    env_aws_secret_access_key = os.environ.get(environment_vars.AWS_SECRET_ACCESS_KEY)
+    # This is normally not available for permanent credentials.
+    env_aws_session_token = os.environ.get(environment_vars.AWS_SESSION_TOKEN)
+    if env_aws_access_key_id and env_aws_secret_access_key:
+        return {
+            "access_key_id": env_aws_access_key_id,
+            "secret_access_key": env_aws_secret_access_key,
+            "security_token": env_aws_session_token,
+        }
+    return None
+
+
+def _parse_expiration(expiration):
+    """Parses the ``Expiration`` of AWS security credentials, for example
+    ``2020-08-11T07:55:22Z``.
+
+    Returns:
+        Optional[datetime.datetime]: The expiration, or None if it is missing
+            or malformed.
+    """
+    try:
+        return datetime.datetime.strptime(expiration, "%Y-%m-%dT%H:%M:%SZ")
+    except (TypeError, ValueError):
+        return None
+
+
+def _fresh(credentials, expiry):
+    """Checks whether cached AWS security credentials can be used without
+    retrieving new ones."""
+    return credentials is not None and (
+        _helpers.utcnow() < expiry - _AWS_SECURITY_CREDENTIALS_REFRESH_AHEAD
+    )
+
+
 class Credentials(external_account.Credentials):
     """AWS external account credentials.
     This is used to exchange serialized AWS signature v4 signed requests to
@@ -412,6 +554,12 @@ class Credentials(external_account.Credentials):
         self._region = None
         self._request_signer = None
         self._target_resource = audience
+        # The IMDSv2 session token and its expiry.
+        self._imdsv2_session_token = (None, None)
+        self._role_name = None
+        # The AWS security credentials from the metadata server and their
+        # expiry.
+        self._metadata_security_credentials = (None, None)
 
         # Get the environment ID. Currently, only one version supported (v1).
         matches = re.match(r"^(aws)([\d]+)$", self._environment_id)
@@ -447,6 +595,11 @@ class Credentials(external_account.Credentials):
         calling the security-credentials endpoint without any argument. Then the
         credentials can be retrieved via: security-credentials/role_name
 
+        The IMDSv2 session token, the role name and the AWS security
+        credentials from the metadata server are cached, the credentials until
+        shortly before their expiration, so that most calls don't need the
+        metadata server.
+
         Generate the signed request to AWS STS GetCallerIdentity action.
 
         Inject x-goog-cloud-target-resource into header and serialize the
@@ -461,37 +614,36 @@ class Credentials(external_account.Credentials):
         Returns:
             str: The retrieved subject token.
         """
-        # Fetch the session token required to make meta data endpoint calls to aws
-        if request is not None and self._imdsv2_session_token_url is not None:
-            headers = {"X-aws-ec2-metadata-token-ttl-seconds": "300"}
-
-            imdsv2_session_token_response = request(
-                url=self._imdsv2_session_token_url, method="PUT", headers=headers
-            )
-
-            if imdsv2_session_token_response.status != 200:
-                raise exceptions.RefreshError(
-                    "Unable to retrieve AWS Session Token",
-                    imdsv2_session_token_response.data,
-                )
-
-            imdsv2_session_token = imdsv2_session_token_response.data
+        # Fetch the session token required to make meta data endpoint calls to
+        # aws, unless the metadata server isn't needed.
+        if (
+            request is not None
+            and self._imdsv2_session_token_url is not None
+            and self._should_use_metadata_server()
+        ):
+            imdsv2_session_token = self._get_imdsv2_session_token(request)
         else:
             imdsv2_session_token = None
 
-        # Initialize the request signer if not yet initialized after determining
-        # the current AWS region.
-        if self._request_signer is None:
-            self._region = self._get_region(
-                request, self._region_url, imdsv2_session_token
+        try:
+            # Initialize the request signer if not yet initialized after
+            # determining the current AWS region.
+            if self._request_signer is None:
+                self._region = self._get_region(
+                    request, self._region_url, imdsv2_session_token
+                )
+                self._request_signer = RequestSigner(self._region)
+
+            # Retrieve the AWS security credentials needed to generate the
+            # signed request.
+            aws_security_credentials = self._get_security_credentials(
+                request, imdsv2_session_token
             )
-            self._request_signer = RequestSigner(self._region)
+        except exceptions.RefreshError:
+            # The session token may have been revoked.
+            self._imdsv2_session_token = (None, None)
+            raise
 
-        # Retrieve the AWS security credentials needed to generate the signed
-        # request.
-        aws_security_credentials = self._get_security_credentials(
-            request, imdsv2_session_token
-        )
         # Generate the signed request to AWS STS GetCallerIdentity API.
         # Use the required regional endpoint. Otherwise, the request will fail.
         request_options = self._request_signer.get_request_options(
@@ -536,6 +688,62 @@ class Credentials(external_account.Credentials):
             json.dumps(aws_signed_req, separators=(",", ":"), sort_keys=True)
         )
 
+    def _should_use_metadata_server(self):
+        """Checks whether the AWS metadata server is needed to determine the
+        region or the AWS security credentials.
+
+        Returns:
+            bool: True if neither the environment nor the cache has them.
+        """
+        if self._request_signer is None and _get_env_region() is None:
+            return True
+        if _get_env_security_credentials() is not None:
+            return False
+        credentials, expiry = self._metadata_security_credentials
+        return not _fresh(credentials, expiry)
+
+    def _get_imdsv2_session_token(self, request):
+        """Retrieves an IMDSv2 session token, reusing the cached one until
+        shortly before it expires.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+
+        Returns:
+            str: The IMDSv2 session token.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If an error occurs while
+                retrieving the session token.
+        """
+        token, expiry = self._imdsv2_session_token
+        if token is not None and (
+            _helpers.utcnow() < expiry - _IMDSV2_SESSION_TOKEN_REFRESH_THRESHOLD
+        ):
+            return token
+
+        headers = {
+            "X-aws-ec2-metadata-token-ttl-seconds": str(_IMDSV2_SESSION_TOKEN_TTL)
+        }
+        expiry = _helpers.utcnow() + datetime.timedelta(
+            seconds=_IMDSV2_SESSION_TOKEN_TTL
+        )
+
+        imdsv2_session_token_response = request(
+            url=self._imdsv2_session_token_url, method="PUT", headers=headers
+        )
+
+        if imdsv2_session_token_response.status != 200:
+            raise exceptions.RefreshError(
+                "Unable to retrieve AWS Session Token",
+                imdsv2_session_token_response.data,
+            )
+
+        token = imdsv2_session_token_response.data
+        self._imdsv2_session_token = (token, expiry)
+        return token
+
     def _get_region(self, request, url, imdsv2_session_token):
         """Retrieves the current AWS region from either the AWS_REGION or
         AWS_DEFAULT_REGION environment variable or from the AWS metadata server.
@@ -557,11 +765,7 @@ class Credentials(external_account.Credentials):
         # The AWS metadata server is not available in some AWS environments
         # such as AWS lambda. Instead, it is available via environment
         # variable.
-        env_aws_region = os.environ.get(environment_vars.AWS_REGION)
-        if env_aws_region is not None:
-            return env_aws_region
-
-        env_aws_region = os.environ.get(environment_vars.AWS_DEFAULT_REGION)
+        env_aws_region = _get_env_region()
         if env_aws_region is not None:
             return env_aws_region
 
@@ -595,6 +799,11 @@ class Credentials(external_account.Credentials):
         requests from either the AWS security credentials environment variables
         or from the AWS metadata server.
 
+        The role name is retrieved from the metadata server once, and the
+        credentials are reused until shortly before their expiration. If they
+        can't be retrieved again by then, the cached ones are used until they
+        expire.
+
         Args:
             request (google.auth.transport.Request): A callable used to make
                 HTTP requests.
@@ -611,32 +820,48 @@ class Credentials(external_account.Credentials):
 
         # Check environment variables for permanent credentials first.
         # https://docs.aws.amazon.com/general/latest/gr/aws-sec-cred-types.html
-        env_aws_access_key_id = os.environ.get(environment_vars.AWS_ACCESS_KEY_ID)
-        env_aws_secret_access_key = os.environ.get(
-            environment_vars.AWS_SECRET_ACCESS_KEY
-        )
-        # This is normally not available for permanent credentials.
-        env_aws_session_token = os.environ.get(environment_vars.AWS_SESSION_TOKEN)
-        if env_aws_access_key_id and env_aws_secret_access_key:
-            return {
-                "access_key_id": env_aws_access_key_id,
-                "secret_access_key": env_aws_secret_access_key,
-                "security_token": env_aws_session_token,
-            }
-
-        # Get role name.
-        role_name = self._get_metadata_role_name(request, imdsv2_session_token)
-
-        # Get security credentials.
-        credentials = self._get_metadata_security_credentials(
-            request, role_name, imdsv2_session_token
-        )
+        env_credentials = _get_env_security_credentials()
+        if env_credentials is not None:
+            return env_credentials
+
+        cached_credentials, cached_expiry = self._metadata_security_credentials
+        if _fresh(cached_credentials, cached_expiry):
+            return cached_credentials
+
+        try:
+            # Get role name.
+            if self._role_name is None:
+                self._role_name = self._get_metadata_role_name(
+                    request, imdsv2_session_token
+                )
 
-        return {
+            # Get security credentials.
+            try:
+                credentials = self._get_metadata_security_credentials(
+                    request, self._role_name, imdsv2_session_token
+                )
+            except exceptions.RefreshError:
+                # The role attached to the instance may have changed.
+                self._role_name = None
+                raise
+        except exceptions.RefreshError as caught_exc:
+            if cached_credentials is None or _helpers.utcnow() >= cached_expiry:
+                raise
+            _LOGGER.warning(
+                "Refreshing AWS security credentials ahead of expiry failed: %s",
+                caught_exc,
+            )
+            return cached_credentials
+
+        security_credentials = {
             "access_key_id": credentials.get("AccessKeyId"),
             "secret_access_key": credentials.get("SecretAccessKey"),
             "security_token": credentials.get("Token"),
         }
+        expiry = _parse_expiration(credentials.get("Expiration"))
+        if expiry is not None:
+            self._metadata_security_credentials = (security_credentials, expiry)
+        return security_credentials
 
     def _get_metadata_security_credentials(
         self, request, role_name, imdsv2_session_token
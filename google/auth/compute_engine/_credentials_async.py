@@ -0,0 +1,188 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Google Compute Engine credentials.
+
+NOTE: This file adds asynchronous refresh methods to the Compute Engine
+credentials classes, and therefore async/await syntax is required when
+calling this method when using Compute Engine credentials with asynchronous
+functionality. The metadata server is queried with
+:mod:`google.auth.compute_engine._metadata_async`, which never blocks the
+event loop. All other methods are inherited from the regular Compute Engine
+credentials file google.auth.compute_engine.credentials
+
+"""
+
+import datetime
+
+import six
+
+from google.auth import _credentials_async as credentials_async
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth import jwt
+from google.auth.compute_engine import _metadata_async
+from google.auth.compute_engine import credentials
+
+
+class Credentials(
+    credentials.Credentials, credentials_async.Scoped, credentials_async.Credentials
+):
+    """Compute Engine Credentials.
+
+    These credentials use the Google Compute Engine metadata server to obtain
+    OAuth 2.0 access tokens associated with the instance's service account.
+    They are refreshed with an async transport, such as
+    :class:`google.auth.transport._aiohttp_requests.Request`::
+
+        credentials = _credentials_async.Credentials()
+        session = _aiohttp_requests.AuthorizedSession(credentials)
+
+    Access tokens are shared with the sync and async credentials in the
+    process for the same service account and set of scopes.
+    """
+
+    async def _retrieve_info(self, request):
+        """Retrieve information about the service account.
+
+        Updates the scopes and retrieves the full service account email.
+
+        Args:
+            request (google.auth.transport.Request): The object used to make
+                HTTP requests.
+        """
+        info = await _metadata_async.get_service_account_info(
+            request, service_account=self._service_account_email
+        )
+
+        self._service_account_email = info["email"]
+
+        # Don't override scopes requested by the user.
+        if self._scopes is None:
+            self._scopes = info["scopes"]
+            self._scopes_from_info = True
+
+        self._info_retrieved = True
+
+    @_helpers.copy_docstring(credentials.Credentials)
+    async def refresh(self, request):
+        scopes = self._scopes if self._scopes is not None else self._default_scopes
+        try:
+            if not self._info_retrieved:
+                await self._retrieve_info(request)
+            self.token, self.expiry = await _metadata_async._token_broker.get_token(
+                request,
+                service_account=self._service_account_email,
+                scopes=scopes,
+                stale_token=self.token,
+            )
+        except exceptions.TransportError as caught_exc:
+            new_exc = exceptions.RefreshError(caught_exc)
+            six.raise_from(new_exc, caught_exc)
+
+
+class IDTokenCredentials(credentials.IDTokenCredentials, credentials_async.Credentials):
+    """Open ID Connect ID Token-based Compute Engine credentials.
+
+    The ID tokens are requested from the `GCE metadata server identity
+    endpoint`_, which is the only source supported by these credentials::
+
+        credentials = _credentials_async.IDTokenCredentials(
+            None, "https://example.com/")
+
+    .. _GCE metadata server identity endpoint:
+        https://cloud.google.com/compute/docs/instances/verifying-instance-identity
+    """
+
+    def __init__(
+        self,
+        request,
+        target_audience,
+        use_metadata_identity_endpoint=True,
+        quota_project_id=None,
+    ):
+        """
+        Args:
+            request (google.auth.transport.Request): Unused, kept for
+                compatibility with the sync credentials.
+            target_audience (str): The intended audience for these credentials,
+                used when requesting the ID Token. The ID Token's ``aud`` claim
+                will be set to this string.
+            use_metadata_identity_endpoint (bool): Must be True.
+            quota_project_id (Optional[str]): The project ID used for quota and
+                billing.
+
+        Raises:
+            ValueError: If ``use_metadata_identity_endpoint`` is False.
+        """
+        # pylint: disable=unused-argument,non-parent-init-called
+        # The sync constructor retrieves the service account email with a
+        # sync request; it is read from the ID token on refresh instead.
+        if not use_metadata_identity_endpoint:
+            raise ValueError(
+                "Async Compute Engine ID token credentials only support the "
+                "metadata identity endpoint."
+            )
+        credentials_async.Credentials.__init__(self)
+        self._quota_project_id = quota_project_id
+        self._use_metadata_identity_endpoint = True
+        self._target_audience = target_audience
+        self._token_uri = None
+        self._additional_claims = None
+        self._signer = None
+        self._service_account_email = "default"
+
+    async def _call_metadata_identity_endpoint(self, request):
+        """Request ID token from metadata identity endpoint.
+
+        Args:
+            request (google.auth.transport.Request): The object used to make
+                HTTP requests.
+
+        Returns:
+            Tuple[str, datetime.datetime]: The ID token and the expiry of the ID token.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If the Compute Engine metadata
+                service can't be reached or if the instance has no credentials.
+            ValueError: If extracting expiry from the obtained ID token fails.
+        """
+        try:
+            path = "instance/service-accounts/default/identity"
+            params = {"audience": self._target_audience, "format": "full"}
+            id_token = await _metadata_async.get(request, path, params=params)
+        except exceptions.TransportError as caught_exc:
+            new_exc = exceptions.RefreshError(caught_exc)
+            six.raise_from(new_exc, caught_exc)
+
+        _, payload, _, _ = jwt._unverified_decode(id_token)
+        if "email" in payload:
+            self._service_account_email = payload["email"]
+        return id_token, datetime.datetime.utcfromtimestamp(payload["exp"])
+
+    async def refresh(self, request):
+        """Refreshes the ID token.
+
+        Args:
+            request (google.auth.transport.Request): The object used to make
+                HTTP requests.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If the credentials could
+                not be refreshed.
+            ValueError: If extracting expiry from the obtained ID token fails.
+        """
+        self.token, self.expiry = await self._call_metadata_identity_endpoint(
+            request
+        )
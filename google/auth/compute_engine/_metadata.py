@@ -21,14 +21,17 @@ import datetime
 import json
 import logging
 import os
+import threading
 
 import six
 from six.moves import http_client
 from six.moves.urllib import parse as urlparse
 
+from google.auth import _exponential_backoff
 from google.auth import _helpers
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import instrumentation
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -59,16 +62,55 @@ try:
 except ValueError:  # pragma: NO COVER
     _METADATA_DEFAULT_TIMEOUT = 3
 
+# The metadata server is local, so retries start quickly. The delays are
+# jittered so that the clients on a throttled host don't retry in lockstep.
+_BACKOFF_INITIAL_DELAY = 0.25
+_BACKOFF_MAX_DELAY = 8.0
+_BACKOFF_SPAN_NAME = "google.auth.compute_engine.metadata.retry"
 
-def ping(request, timeout=_METADATA_DEFAULT_TIMEOUT, retry_count=3):
+# Status codes returned by a throttled or restarting metadata server.
+_RETRYABLE_STATUS_CODES = (
+    429,  # Too Many Requests
+    http_client.SERVICE_UNAVAILABLE,
+)
+
+
+def _backoff(retry_count, deadline):
+    return _exponential_backoff.ExponentialBackoff(
+        total_attempts=retry_count,
+        initial_delay=_BACKOFF_INITIAL_DELAY,
+        max_delay=_BACKOFF_MAX_DELAY,
+        deadline=deadline,
+        span_name=_BACKOFF_SPAN_NAME,
+    )
+
+
+def _should_retry(response, backoff):
+    """Checks whether a response is worth retrying, honoring its
+    ``Retry-After`` header."""
+    if response.status not in _RETRYABLE_STATUS_CODES:
+        return False
+    backoff.retry_after(
+        _exponential_backoff.parse_retry_after(response.headers.get("retry-after"))
+    )
+    return True
+
+
+@instrumentation._traced("google.auth.compute_engine.metadata.ping")
+def ping(request, timeout=_METADATA_DEFAULT_TIMEOUT, retry_count=3, deadline=None):
     """Checks to see if the metadata server is available.
 
+    Failed attempts are retried with exponential backoff and jitter.
+
     Args:
         request (google.auth.transport.Request): A callable used to make
             HTTP requests.
         timeout (int): How long to wait for the metadata server to respond.
         retry_count (int): How many times to attempt connecting to metadata
             server using above timeout.
+        deadline (Optional[float]): The overall time limit in seconds for all
+            the attempts, including the delays between them. Each attempt
+            waits at most for the time left.
 
     Returns:
         bool: True if the metadata server is reachable, False otherwise.
@@ -79,46 +121,68 @@ def ping(request, timeout=_METADATA_DEFAULT_TIMEOUT, retry_count=3):
     #       could lead to false negatives in the event that we are on GCE, but
     #       the metadata resolution was particularly slow. The latter case is
     #       "unlikely".
-    retries = 0
-    while retries < retry_count:
+    backoff = _backoff(retry_count, deadline)
+    for attempt in backoff:
+        remaining = backoff.remaining()
         try:
             response = request(
                 url=_METADATA_IP_ROOT,
                 method="GET",
                 headers=_METADATA_HEADERS,
-                timeout=timeout,
-            )
-
-            metadata_flavor = response.headers.get(_METADATA_FLAVOR_HEADER)
-            return (
-                response.status == http_client.OK
-                and metadata_flavor == _METADATA_FLAVOR_VALUE
+                timeout=timeout if remaining is None else min(timeout, remaining),
             )
 
         except exceptions.TransportError as e:
             _LOGGER.warning(
                 "Compute Engine Metadata server unavailable on "
                 "attempt %s of %s. Reason: %s",
-                retries + 1,
+                attempt,
                 retry_count,
                 e,
             )
-            retries += 1
+            continue
+
+        if _should_retry(response, backoff):
+            _LOGGER.warning(
+                "Compute Engine Metadata server throttled on attempt %s of %s. "
+                "Status: %s",
+                attempt,
+                retry_count,
+                response.status,
+            )
+            continue
+
+        metadata_flavor = response.headers.get(_METADATA_FLAVOR_HEADER)
+        return (
+            response.status == http_client.OK
+            and metadata_flavor == _METADATA_FLAVOR_VALUE
+        )
 
     return False
 
 
+@instrumentation._traced("google.auth.compute_engine.metadata.get")
 def get(
-    request, path, root=_METADATA_ROOT, params=None, recursive=False, retry_count=5
+    request,
+    path,
+    root=None,
+    params=None,
+    recursive=False,
+    retry_count=5,
+    deadline=None,
 ):
     """Fetch a resource from the metadata server.
 
+    Connection failures and throttling responses (429 and 503) are retried
+    with exponential backoff and jitter, honoring ``Retry-After``.
+
     Args:
         request (google.auth.transport.Request): A callable used to make
             HTTP requests.
         path (str): The resource to retrieve. For example,
             ``'instance/service-accounts/default'``.
-        root (str): The full path to the metadata server root.
+        root (Optional[str]): The full path to the metadata server root.
+            Defaults to the root configured by the environment.
         params (Optional[Mapping[str, str]]): A mapping of query parameter
             keys to values.
         recursive (bool): Whether to do a recursive query of metadata. See
@@ -126,6 +190,9 @@ def get(
             details.
         retry_count (int): How many times to attempt connecting to metadata
             server using above timeout.
+        deadline (Optional[float]): The overall time limit in seconds for all
+            the attempts, including the delays between them. Each attempt
+            waits at most for the time left.
 
     Returns:
         Union[Mapping, str]: If the metadata server returns JSON, a mapping of
@@ -136,6 +203,8 @@ def get(
         google.auth.exceptions.TransportError: if an error occurred while
             retrieving metadata.
     """
+    if root is None:
+        root = _METADATA_ROOT
     base_url = urlparse.urljoin(root, path)
     query_params = {} if params is None else params
 
@@ -144,22 +213,38 @@ def get(
 
     url = _helpers.update_query(base_url, query_params)
 
-    retries = 0
-    while retries < retry_count:
+    response = None
+    backoff = _backoff(retry_count, deadline)
+    for attempt in backoff:
+        kwargs = {}
+        if deadline is not None:
+            kwargs["timeout"] = backoff.remaining()
         try:
-            response = request(url=url, method="GET", headers=_METADATA_HEADERS)
-            break
-
+            response = request(
+                url=url, method="GET", headers=_METADATA_HEADERS, **kwargs
+            )
         except exceptions.TransportError as e:
             _LOGGER.warning(
                 "Compute Engine Metadata server unavailable on "
                 "attempt %s of %s. Reason: %s",
-                retries + 1,
+                attempt,
                 retry_count,
                 e,
             )
-            retries += 1
-    else:
+            response = None
+            continue
+
+        if not _should_retry(response, backoff):
+            break
+        _LOGGER.warning(
+            "Compute Engine Metadata server throttled on attempt %s of %s. "
+            "Status: %s",
+            attempt,
+            retry_count,
+            response.status,
+        )
+
+    if response is None:
         raise exceptions.TransportError(
             "Failed to retrieve {} from the Google Compute Engine "
             "metadata service. Compute Engine Metadata server unavailable".format(url)
@@ -265,3 +350,99 @@ def get_service_account_token(request, service_account="default", scopes=None):
         seconds=token_json["expires_in"]
     )
     return token_json["access_token"], token_expiry
+
+
+def _canonical_scopes(scopes):
+    """Returns a hashable, order-independent form of a set of scopes."""
+    if not scopes:
+        return ()
+    if isinstance(scopes, six.string_types):
+        scopes = scopes.split(",")
+    return tuple(sorted(set(scope.strip() for scope in scopes if scope.strip())))
+
+
+class _ServiceAccountTokens(object):
+    """The latest access token for one service account and set of scopes."""
+
+    def __init__(self):
+        # Held while fetching, so that concurrent fetches are coalesced.
+        self.lock = threading.Lock()
+        # The token and its expiry, read and replaced together.
+        self.token = (None, None)
+
+
+class _TokenBroker(object):
+    """Shares the access tokens of the metadata server within the process.
+
+    Tokens are cached by metadata server, service account and canonical set
+    of scopes, so that all the credentials for the same identity, such as the
+    scoped copies made by different client libraries, are served by a single
+    token. Concurrent requests for a token that isn't cached share a single
+    metadata request.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._tokens = {}
+
+    def _get_tokens(self, key):
+        tokens = self._tokens.get(key)
+        if tokens is None:
+            with self._lock:
+                tokens = self._tokens.setdefault(key, _ServiceAccountTokens())
+        return tokens
+
+    @staticmethod
+    def _usable(token, expiry, stale_token):
+        return (
+            token is not None
+            and token != stale_token
+            and _helpers.utcnow() < expiry - _helpers.REFRESH_THRESHOLD
+        )
+
+    def get_token(
+        self, request, service_account="default", scopes=None, stale_token=None
+    ):
+        """Gets an access token, fetching one if none is cached.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+            service_account (str): The string 'default' or a service account
+                email address.
+            scopes (Optional[Union[str, List[str]]]): The scopes of the token.
+            stale_token (Optional[str]): A token the caller already has and
+                wants replaced, for example after it was rejected. It is not
+                returned even if it is still cached.
+
+        Returns:
+            Tuple[str, datetime]: The access token and its expiration.
+
+        Raises:
+            google.auth.exceptions.TransportError: if an error occurred while
+                retrieving metadata.
+        """
+        key = (_METADATA_ROOT, service_account, _canonical_scopes(scopes))
+        tokens = self._get_tokens(key)
+        token, expiry = tokens.token
+        if self._usable(token, expiry, stale_token):
+            return token, expiry
+
+        with tokens.lock:
+            # Another thread may have fetched a token while this one waited.
+            token, expiry = tokens.token
+            if self._usable(token, expiry, stale_token):
+                return token, expiry
+
+            tokens.token = get_service_account_token(
+                request, service_account=service_account, scopes=scopes
+            )
+            return tokens.token
+
+    def clear(self):
+        """Drops all the cached tokens."""
+        with self._lock:
+            self._tokens.clear()
+
+
+_token_broker = _TokenBroker()
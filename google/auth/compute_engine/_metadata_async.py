@@ -0,0 +1,382 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Provides async helper methods for talking to the Compute Engine metadata
+server.
+
+NOTE: This file mirrors :mod:`google.auth.compute_engine._metadata` with
+async/await syntax, for use with the
+:class:`google.auth.transport._aiohttp_requests.Request` transport. Every
+request has a timeout and retries wait on the event loop, so a slow or
+missing metadata server never blocks it.
+
+See https://cloud.google.com/compute/docs/metadata for more details.
+"""
+
+import asyncio
+import datetime
+import json
+import weakref
+
+import six
+from six.moves import http_client
+from six.moves.urllib import parse as urlparse
+
+from google.auth import _exponential_backoff_async
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth import instrumentation
+from google.auth.compute_engine import _metadata
+
+_LOGGER = _metadata._LOGGER
+
+# How long (in seconds) to wait for each metadata server response, instead of
+# the much longer default of the aiohttp transport.
+_DEFAULT_REQUEST_TIMEOUT = 30
+
+
+def _backoff(retry_count, deadline):
+    return _exponential_backoff_async.AsyncExponentialBackoff(
+        total_attempts=retry_count,
+        initial_delay=_metadata._BACKOFF_INITIAL_DELAY,
+        max_delay=_metadata._BACKOFF_MAX_DELAY,
+        deadline=deadline,
+        span_name=_metadata._BACKOFF_SPAN_NAME,
+    )
+
+
+def _attempt_timeout(timeout, backoff):
+    remaining = backoff.remaining()
+    return timeout if remaining is None else min(timeout, remaining)
+
+
+async def ping(
+    request, timeout=_metadata._METADATA_DEFAULT_TIMEOUT, retry_count=3, deadline=None
+):
+    """Checks to see if the metadata server is available.
+
+    Failed attempts are retried with exponential backoff and jitter.
+
+    Args:
+        request (google.auth.transport.Request): A callable used to make
+            HTTP requests.
+        timeout (int): How long to wait for the metadata server to respond.
+        retry_count (int): How many times to attempt connecting to metadata
+            server using above timeout.
+        deadline (Optional[float]): The overall time limit in seconds for all
+            the attempts, including the delays between them. Each attempt
+            waits at most for the time left.
+
+    Returns:
+        bool: True if the metadata server is reachable, False otherwise.
+    """
+    with instrumentation._span("google.auth.compute_engine.metadata.ping"):
+        backoff = _backoff(retry_count, deadline)
+        async for attempt in backoff:
+            try:
+                response = await request(
+                    url=_metadata._METADATA_IP_ROOT,
+                    method="GET",
+                    headers=_metadata._METADATA_HEADERS,
+                    timeout=_attempt_timeout(timeout, backoff),
+                )
+            except exceptions.TransportError as e:
+                _LOGGER.warning(
+                    "Compute Engine Metadata server unavailable on "
+                    "attempt %s of %s. Reason: %s",
+                    attempt,
+                    retry_count,
+                    e,
+                )
+                continue
+
+            if _metadata._should_retry(response, backoff):
+                _LOGGER.warning(
+                    "Compute Engine Metadata server throttled on attempt %s of "
+                    "%s. Status: %s",
+                    attempt,
+                    retry_count,
+                    response.status,
+                )
+                continue
+
+            metadata_flavor = response.headers.get(_metadata._METADATA_FLAVOR_HEADER)
+            return (
+                response.status == http_client.OK
+                and metadata_flavor == _metadata._METADATA_FLAVOR_VALUE
+            )
+
+        return False
+
+
+async def get(
+    request,
+    path,
+    root=None,
+    params=None,
+    recursive=False,
+    retry_count=5,
+    timeout=_DEFAULT_REQUEST_TIMEOUT,
+    deadline=None,
+):
+    """Fetch a resource from the metadata server.
+
+    Connection failures and throttling responses (429 and 503) are retried
+    with exponential backoff and jitter, honoring ``Retry-After``.
+
+    Args:
+        request (google.auth.transport.Request): A callable used to make
+            HTTP requests.
+        path (str): The resource to retrieve. For example,
+            ``'instance/service-accounts/default'``.
+        root (Optional[str]): The full path to the metadata server root.
+            Defaults to the root configured by the environment.
+        params (Optional[Mapping[str, str]]): A mapping of query parameter
+            keys to values.
+        recursive (bool): Whether to do a recursive query of metadata. See
+            https://cloud.google.com/compute/docs/metadata#aggcontents for more
+            details.
+        retry_count (int): How many times to attempt connecting to metadata
+            server using above timeout.
+        timeout (int): How long to wait for each response.
+        deadline (Optional[float]): The overall time limit in seconds for all
+            the attempts, including the delays between them. Each attempt
+            waits at most for the time left.
+
+    Returns:
+        Union[Mapping, str]: If the metadata server returns JSON, a mapping of
+            the decoded JSON is return. Otherwise, the response content is
+            returned as a string.
+
+    Raises:
+        google.auth.exceptions.TransportError: if an error occurred while
+            retrieving metadata.
+    """
+    if root is None:
+        root = _metadata._METADATA_ROOT
+    base_url = urlparse.urljoin(root, path)
+    query_params = {} if params is None else params
+
+    if recursive:
+        query_params["recursive"] = "true"
+
+    url = _helpers.update_query(base_url, query_params)
+
+    with instrumentation._span("google.auth.compute_engine.metadata.get"):
+        response = None
+        backoff = _backoff(retry_count, deadline)
+        async for attempt in backoff:
+            try:
+                response = await request(
+                    url=url,
+                    method="GET",
+                    headers=_metadata._METADATA_HEADERS,
+                    timeout=_attempt_timeout(timeout, backoff),
+                )
+            except exceptions.TransportError as e:
+                _LOGGER.warning(
+                    "Compute Engine Metadata server unavailable on "
+                    "attempt %s of %s. Reason: %s",
+                    attempt,
+                    retry_count,
+                    e,
+                )
+                response = None
+                continue
+
+            if not _metadata._should_retry(response, backoff):
+                break
+            _LOGGER.warning(
+                "Compute Engine Metadata server throttled on attempt %s of %s. "
+                "Status: %s",
+                attempt,
+                retry_count,
+                response.status,
+            )
+
+        if response is None:
+            raise exceptions.TransportError(
+                "Failed to retrieve {} from the Google Compute Engine "
+                "metadata service. Compute Engine Metadata server "
+                "unavailable".format(url)
+            )
+
+        data = await response.content()
+
+    if response.status == http_client.OK:
+        content = _helpers.from_bytes(data)
+        if response.headers["content-type"] == "application/json":
+            try:
+                return json.loads(content)
+            except ValueError as caught_exc:
+                new_exc = exceptions.TransportError(
+                    "Received invalid JSON from the Google Compute Engine "
+                    "metadata service: {:.20}".format(content)
+                )
+                six.raise_from(new_exc, caught_exc)
+        else:
+            return content
+    else:
+        raise exceptions.TransportError(
+            "Failed to retrieve {} from the Google Compute Engine "
+            "metadata service. Status: {} Response:\n{}".format(
+                url, response.status, data
+            ),
+            response,
+        )
+
+
+async def get_project_id(request):
+    """Get the Google Cloud Project ID from the metadata server.
+
+    Args:
+        request (google.auth.transport.Request): A callable used to make
+            HTTP requests.
+
+    Returns:
+        str: The project ID
+
+    Raises:
+        google.auth.exceptions.TransportError: if an error occurred while
+            retrieving metadata.
+    """
+    return await get(request, "project/project-id")
+
+
+async def get_service_account_info(request, service_account="default"):
+    """Get information about a service account from the metadata server.
+
+    Args:
+        request (google.auth.transport.Request): A callable used to make
+            HTTP requests.
+        service_account (str): The string 'default' or a service account email
+            address. The determines which service account for which to acquire
+            information.
+
+    Returns:
+        Mapping: The service account's information, for example::
+
+            {
+                'email': '...',
+                'scopes': ['scope', ...],
+                'aliases': ['default', '...']
+            }
+
+    Raises:
+        google.auth.exceptions.TransportError: if an error occurred while
+            retrieving metadata.
+    """
+    path = "instance/service-accounts/{0}/".format(service_account)
+    return await get(request, path, params={"recursive": "true"})
+
+
+async def get_service_account_token(request, service_account="default", scopes=None):
+    """Get the OAuth 2.0 access token for a service account.
+
+    Args:
+        request (google.auth.transport.Request): A callable used to make
+            HTTP requests.
+        service_account (str): The string 'default' or a service account email
+            address. The determines which service account for which to acquire
+            an access token.
+        scopes (Optional[Union[str, List[str]]]): Optional string or list of
+            strings with auth scopes.
+    Returns:
+        Union[str, datetime]: The access token and its expiration.
+
+    Raises:
+        google.auth.exceptions.TransportError: if an error occurred while
+            retrieving metadata.
+    """
+    if scopes:
+        if not isinstance(scopes, str):
+            scopes = ",".join(scopes)
+        params = {"scopes": scopes}
+    else:
+        params = None
+
+    path = "instance/service-accounts/{0}/token".format(service_account)
+    token_json = await get(request, path, params=params)
+    token_expiry = _helpers.utcnow() + datetime.timedelta(
+        seconds=token_json["expires_in"]
+    )
+    return token_json["access_token"], token_expiry
+
+
+class _AsyncTokenBroker(object):
+    """Shares the access tokens of the metadata server between async
+    credentials.
+
+    The tokens are cached by the sync token broker of
+    :mod:`google.auth.compute_engine._metadata`, so sync and async credentials
+    for the same identity share them too. Concurrent fetches of a token on an
+    event loop are coalesced with an :class:`asyncio.Lock`.
+    """
+
+    def __init__(self):
+        # The locks of each event loop, by token key.
+        self._locks = weakref.WeakKeyDictionary()
+
+    def _get_lock(self, key):
+        locks = self._locks.setdefault(asyncio.get_event_loop(), {})
+        lock = locks.get(key)
+        if lock is None:
+            lock = locks[key] = asyncio.Lock()
+        return lock
+
+    async def get_token(
+        self, request, service_account="default", scopes=None, stale_token=None
+    ):
+        """Gets an access token, fetching one if none is cached.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+            service_account (str): The string 'default' or a service account
+                email address.
+            scopes (Optional[Union[str, List[str]]]): The scopes of the token.
+            stale_token (Optional[str]): A token the caller already has and
+                wants replaced. It is not returned even if it is still cached.
+
+        Returns:
+            Tuple[str, datetime]: The access token and its expiration.
+
+        Raises:
+            google.auth.exceptions.TransportError: if an error occurred while
+                retrieving metadata.
+        """
+        key = (
+            _metadata._METADATA_ROOT,
+            service_account,
+            _metadata._canonical_scopes(scopes),
+        )
+        broker = _metadata._token_broker
+        tokens = broker._get_tokens(key)
+        token, expiry = tokens.token
+        if broker._usable(token, expiry, stale_token):
+            return token, expiry
+
+        async with self._get_lock(key):
+            # Another task may have fetched a token while this one waited.
+            token, expiry = tokens.token
+            if broker._usable(token, expiry, stale_token):
+                return token, expiry
+
+            tokens.token = await get_service_account_token(
+                request, service_account=service_account, scopes=scopes
+            )
+            return tokens.token
+
+
+_token_broker = _AsyncTokenBroker()
@@ -47,6 +47,11 @@ class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
     .. note:: On Compute Engine the metadata server ignores requested scopes.
         On Cloud Run, Flex and App Engine the server honours requested scopes.
 
+    Access tokens are shared by all the credentials in the process for the
+    same service account and set of scopes, whatever the order of the
+    scopes, so that copies made with :meth:`with_scopes` or
+    :meth:`with_quota_project` don't each fetch their own token.
+
     .. _Compute Engine authentication documentation:
         https://cloud.google.com/compute/docs/authentication#using
     """
@@ -74,6 +79,10 @@ class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
         self._quota_project_id = quota_project_id
         self._scopes = scopes
         self._default_scopes = default_scopes
+        # The service account info rarely changes, so it is only retrieved
+        # on the first refresh (or after invalidate_service_account_info).
+        self._info_retrieved = False
+        self._scopes_from_info = False
 
     def _retrieve_info(self, request):
         """Retrieve information about the service account.
@@ -93,6 +102,22 @@ class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
         # Don't override scopes requested by the user.
         if self._scopes is None:
             self._scopes = info["scopes"]
+            self._scopes_from_info = True
+
+        self._info_retrieved = True
+
+    def invalidate_service_account_info(self):
+        """Makes the next :meth:`refresh` retrieve the service account info.
+
+        The service account email and scopes are retrieved from the metadata
+        server on the first refresh only, and later refreshes just fetch a
+        token. Call this if the instance's service account or its scopes were
+        changed.
+        """
+        self._info_retrieved = False
+        if self._scopes_from_info:
+            self._scopes = None
+            self._scopes_from_info = False
 
     def refresh(self, request):
         """Refresh the access token and scopes.
@@ -108,9 +133,13 @@ class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
         """
         scopes = self._scopes if self._scopes is not None else self._default_scopes
         try:
-            self._retrieve_info(request)
-            self.token, self.expiry = _metadata.get_service_account_token(
-                request, service_account=self._service_account_email, scopes=scopes
+            if not self._info_retrieved:
+                self._retrieve_info(request)
+            self.token, self.expiry = _metadata._token_broker.get_token(
+                request,
+                service_account=self._service_account_email,
+                scopes=scopes,
+                stale_token=self.token,
             )
         except exceptions.TransportError as caught_exc:
             new_exc = exceptions.RefreshError(caught_exc)
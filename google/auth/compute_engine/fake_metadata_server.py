@@ -0,0 +1,578 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""A local fake of the Compute Engine metadata server.
+
+:class:`FakeMetadataServer` is a pure-Python HTTP server answering the
+requests this library makes to the metadata server: the ping, the project
+ID, instance and project attributes, service account information, access
+tokens and ID tokens. It can add latency to every response, fail requests on
+demand, and holds ``wait_for_change`` requests open until the value they
+watch changes, so that code depending on the metadata server can be tested
+and benchmarked anywhere::
+
+    from google.auth.compute_engine import fake_metadata_server
+
+    with fake_metadata_server.FakeMetadataServer(
+            project_id="my-project") as server:
+        credentials, project_id = google.auth.default()
+        server.set("instance/attributes/my-key", "value")
+        server.inject_error(503, count=2)
+        ...
+
+Entering the server starts it and points this process at it. Other
+processes use it through the ``GCE_METADATA_HOST`` and ``GCE_METADATA_IP``
+environment variables, see :attr:`FakeMetadataServer.environ`. It can also
+be run on its own::
+
+    $ python -m google.auth.compute_engine.fake_metadata_server --port 8080
+    GCE_METADATA_HOST=127.0.0.1:8080
+    GCE_METADATA_IP=127.0.0.1:8080
+
+The tokens it returns are only valid for the fake: access tokens are opaque
+strings, and ID tokens are JWTs with a placeholder signature unless a
+``signer`` is given.
+"""
+
+import argparse
+import copy
+import hashlib
+import json
+import os
+import threading
+import time
+
+from six.moves import BaseHTTPServer
+from six.moves import http_client
+from six.moves import socketserver
+from six.moves.urllib import parse as urlparse
+
+from google.auth import _helpers
+from google.auth import environment_vars
+from google.auth import jwt
+from google.auth.compute_engine import _metadata
+
+_PATH_PREFIX = "/computeMetadata/v1/"
+_DEFAULT_PROJECT_ID = "example-project"
+_DEFAULT_NUMERIC_PROJECT_ID = 123456789012
+_DEFAULT_SCOPES = ["https://www.googleapis.com/auth/cloud-platform"]
+_DEFAULT_TOKEN_LIFETIME = 3600
+# How long (in seconds) a wait_for_change request is held open by default.
+_DEFAULT_TIMEOUT_SEC = 60
+# Directories whose children are user-defined names, which the recursive
+# JSON representation leaves as they are instead of camel casing them.
+_VERBATIM_DIRECTORIES = ("attributes", "service-accounts")
+# How often (in seconds) the serving thread checks for shutdown.
+_POLL_INTERVAL = 0.05
+
+
+def _camel_case(name):
+    parts = name.split("-")
+    return parts[0] + "".join(part.capitalize() for part in parts[1:])
+
+
+def _to_json(value, verbatim=False):
+    """Converts a metadata tree to its recursive JSON representation."""
+    if not isinstance(value, dict):
+        return value
+    return {
+        (key if verbatim else _camel_case(key)): _to_json(
+            child, key in _VERBATIM_DIRECTORIES
+        )
+        for key, child in value.items()
+    }
+
+
+def _to_text(value):
+    """Converts a metadata value to its non-recursive text representation."""
+    if isinstance(value, dict):
+        return "\n".join(
+            key + "/" if isinstance(child, dict) else key
+            for key, child in sorted(value.items())
+        )
+    if isinstance(value, (list, tuple)):
+        return "\n".join(str(item) for item in value)
+    if isinstance(value, bool):
+        return "TRUE" if value else "FALSE"
+    return str(value)
+
+
+def _split(path):
+    return [segment for segment in path.split("/") if segment]
+
+
+def _default_metadata(project_id, service_account_email):
+    service_account = {
+        "aliases": ["default"],
+        "email": service_account_email,
+        "scopes": list(_DEFAULT_SCOPES),
+    }
+    return {
+        "instance": {
+            "attributes": {},
+            "hostname": "instance.c.{}.internal".format(project_id),
+            "id": 1234567890123456789,
+            "maintenance-event": "NONE",
+            "service-accounts": {
+                "default": service_account,
+                service_account_email: copy.deepcopy(service_account),
+            },
+            "zone": "projects/{}/zones/us-central1-a".format(
+                _DEFAULT_NUMERIC_PROJECT_ID
+            ),
+        },
+        "project": {
+            "attributes": {},
+            "numeric-project-id": _DEFAULT_NUMERIC_PROJECT_ID,
+            "project-id": project_id,
+        },
+    }
+
+
+class _Fault(object):
+    def __init__(self, status, count, retry_after, path):
+        self.status = status
+        self.count = count
+        self.retry_after = retry_after
+        self.path = path
+
+    def matches(self, path):
+        return self.path is None or path.startswith(self.path)
+
+
+class _Handler(BaseHTTPServer.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    # Send each response in a single write to avoid delayed-ACK stalls.
+    wbufsize = -1
+
+    def do_GET(self):
+        fake = self.server.fake
+        url = urlparse.urlsplit(self.path)
+        query = dict(urlparse.parse_qsl(url.query))
+        fake._record(self.path)
+
+        if fake.latency:
+            time.sleep(fake.latency)
+
+        fault = fake._take_fault(url.path)
+        if fault is not None:
+            if fault.status is None:
+                # Simulates a connection failure.
+                self.close_connection = True
+                return
+            headers = {}
+            if fault.retry_after is not None:
+                headers["Retry-After"] = str(fault.retry_after)
+            self._send(fault.status, "Injected error.", headers=headers)
+            return
+
+        if url.path == "/":
+            self._send(http_client.OK, "computeMetadata/\n")
+            return
+
+        flavor = self.headers.get(_metadata._METADATA_FLAVOR_HEADER)
+        if flavor != _metadata._METADATA_FLAVOR_VALUE:
+            self._send(http_client.FORBIDDEN, "Missing Metadata-Flavor header.")
+            return
+
+        if not url.path.startswith(_PATH_PREFIX):
+            self._send(http_client.NOT_FOUND, "Not found.")
+            return
+
+        segments = _split(url.path[len(_PATH_PREFIX) :])
+        if (
+            len(segments) == 4
+            and segments[:2] == ["instance", "service-accounts"]
+            and segments[3] in ("token", "identity")
+        ):
+            self._service_account_endpoint(segments[2], segments[3], query)
+            return
+
+        self._metadata(segments, url.path.endswith("/"), query)
+
+    def _service_account_endpoint(self, service_account, endpoint, query):
+        fake = self.server.fake
+        with fake._condition:
+            accounts = fake._metadata["instance"].get("service-accounts", {})
+            info = copy.deepcopy(accounts.get(service_account))
+        if info is None:
+            self._send(http_client.NOT_FOUND, "Unknown service account.")
+            return
+
+        if endpoint == "token":
+            body = json.dumps(fake._issue_access_token(query.get("scopes")))
+            self._send(http_client.OK, body, content_type="application/json")
+            return
+
+        audience = query.get("audience")
+        if not audience:
+            self._send(
+                http_client.BAD_REQUEST, "non-empty audience parameter required"
+            )
+            return
+        full = query.get("format") == "full"
+        self._send(http_client.OK, fake._issue_id_token(info["email"], audience, full))
+
+    def _metadata(self, segments, is_directory, query):
+        fake = self.server.fake
+        recursive = query.get("recursive", "").lower() == "true"
+        wait_for_change = query.get("wait_for_change", "").lower() == "true"
+        timeout_sec = float(query.get("timeout_sec", _DEFAULT_TIMEOUT_SEC))
+
+        value, etag = fake._lookup(segments)
+        if wait_for_change and query.get("last_etag", etag) == etag:
+            value, etag = fake._wait_for_change(segments, etag, timeout_sec)
+
+        if value is None:
+            self._send(http_client.NOT_FOUND, "Not found.")
+            return
+        if isinstance(value, dict) and not is_directory and not recursive:
+            # The metadata server redirects directories to their slashed path.
+            location = _PATH_PREFIX + "/".join(segments) + "/"
+            self._send(
+                http_client.MOVED_PERMANENTLY, "", headers={"Location": location}
+            )
+            return
+
+        headers = {"ETag": etag}
+        if recursive:
+            verbatim = bool(segments) and segments[-1] in _VERBATIM_DIRECTORIES
+            body = json.dumps(_to_json(value, verbatim))
+            self._send(
+                http_client.OK, body, content_type="application/json", headers=headers
+            )
+        else:
+            self._send(http_client.OK, _to_text(value), headers=headers)
+
+    def _send(self, status, body, content_type="application/text", headers=None):
+        data = _helpers.to_bytes(body)
+        self.send_response(status)
+        self.send_header("Metadata-Flavor", _metadata._METADATA_FLAVOR_VALUE)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(data)))
+        for key, value in (headers or {}).items():
+            self.send_header(key, value)
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_message(self, *args):
+        pass
+
+
+class _HTTPServer(socketserver.ThreadingMixIn, BaseHTTPServer.HTTPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+class FakeMetadataServer(object):
+    """A local fake of the Compute Engine metadata server.
+
+    The metadata is a tree of nested mappings, with the ``instance`` and
+    ``project`` directories at its root; leaves are strings, numbers or lists.
+    Service accounts in ``instance/service-accounts`` get a ``token`` and an
+    ``identity`` endpoint.
+
+    Args:
+        project_id (str): The project ID served by the fake.
+        service_account_email (Optional[str]): The email of the default
+            service account. Defaults to the Compute Engine default service
+            account of the project.
+        metadata (Optional[Mapping[str, Mapping]]): The metadata tree to
+            serve instead of the default one.
+        latency (float): How long (in seconds) to wait before answering each
+            request.
+        token_lifetime (int): The lifetime (in seconds) of the tokens issued.
+        signer (Optional[google.auth.crypt.Signer]): The signer used to sign
+            ID tokens. ID tokens have a placeholder signature if None.
+        host (str): The address to listen on.
+        port (int): The port to listen on, or 0 to pick a free port.
+    """
+
+    def __init__(
+        self,
+        project_id=_DEFAULT_PROJECT_ID,
+        service_account_email=None,
+        metadata=None,
+        latency=0,
+        token_lifetime=_DEFAULT_TOKEN_LIFETIME,
+        signer=None,
+        host="127.0.0.1",
+        port=0,
+    ):
+        if service_account_email is None:
+            service_account_email = "{}-compute@developer.gserviceaccount.com".format(
+                _DEFAULT_NUMERIC_PROJECT_ID
+            )
+        if metadata is None:
+            metadata = _default_metadata(project_id, service_account_email)
+        self._metadata = copy.deepcopy(metadata)
+        self.latency = latency
+        self.token_lifetime = token_lifetime
+        self._signer = signer
+        self._condition = threading.Condition()
+        self._faults = []
+        self._token_count = 0
+        self._closed = False
+        self._installed = None
+        self.requests = []
+
+        self._server = _HTTPServer((host, port), _Handler)
+        self._server.fake = self
+        self._thread = None
+
+    @property
+    def host(self):
+        """str: The ``host:port`` the server listens on."""
+        host, port = self._server.server_address[:2]
+        return "{}:{}".format(host, port)
+
+    @property
+    def environ(self):
+        """Mapping[str, str]: The environment variables pointing a process at
+        the server. They are read when :mod:`google.auth.compute_engine` is
+        imported."""
+        return {
+            environment_vars.GCE_METADATA_HOST: self.host,
+            environment_vars.GCE_METADATA_IP: self.host,
+        }
+
+    def start(self):
+        """Starts serving requests on a background thread."""
+        self._thread = threading.Thread(
+            target=self._server.serve_forever,
+            kwargs={"poll_interval": _POLL_INTERVAL},
+            name="fake-metadata-server",
+        )
+        self._thread.daemon = True
+        self._thread.start()
+
+    def install(self):
+        """Points this process at the server.
+
+        Sets the environment variables in :attr:`environ`, which also applies
+        to child processes, and the metadata server location already read
+        by :mod:`google.auth.compute_engine`. :meth:`close` restores both.
+        """
+        if self._installed is not None:
+            return
+        self._installed = (
+            {name: os.environ.get(name) for name in self.environ},
+            _metadata._METADATA_ROOT,
+            _metadata._METADATA_IP_ROOT,
+        )
+        os.environ.update(self.environ)
+        _metadata._METADATA_ROOT = "http://{}/computeMetadata/v1/".format(self.host)
+        _metadata._METADATA_IP_ROOT = "http://{}".format(self.host)
+
+    def _uninstall(self):
+        if self._installed is None:
+            return
+        environ, root, ip_root = self._installed
+        self._installed = None
+        for name, value in environ.items():
+            if value is None:
+                os.environ.pop(name, None)
+            else:
+                os.environ[name] = value
+        _metadata._METADATA_ROOT = root
+        _metadata._METADATA_IP_ROOT = ip_root
+
+    def close(self):
+        """Stops the server, ends the pending ``wait_for_change`` requests and
+        undoes :meth:`install`."""
+        self._uninstall()
+        with self._condition:
+            self._closed = True
+            self._condition.notify_all()
+        if self._thread is not None:
+            self._server.shutdown()
+            self._thread.join()
+            self._thread = None
+        self._server.server_close()
+
+    def __enter__(self):
+        self.start()
+        self.install()
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def serve_forever(self):
+        """Serves requests on the calling thread until interrupted."""
+        try:
+            self._server.serve_forever()
+        finally:
+            self.close()
+
+    def set(self, path, value):
+        """Sets a metadata value, creating the missing directories.
+
+        Pending ``wait_for_change`` requests for the path and its parents
+        return the new value.
+
+        Args:
+            path (str): The path to set, for example
+                ``'instance/attributes/my-key'``.
+            value (Union[str, int, list, Mapping]): The new value.
+        """
+        segments = _split(path)
+        with self._condition:
+            directory = self._metadata
+            for segment in segments[:-1]:
+                directory = directory.setdefault(segment, {})
+            directory[segments[-1]] = copy.deepcopy(value)
+            self._condition.notify_all()
+
+    def delete(self, path):
+        """Removes a metadata value, if it exists.
+
+        Args:
+            path (str): The path to remove.
+        """
+        segments = _split(path)
+        with self._condition:
+            directory = self._metadata
+            for segment in segments[:-1]:
+                directory = directory.get(segment)
+                if not isinstance(directory, dict):
+                    return
+            if segments[-1] in directory:
+                del directory[segments[-1]]
+                self._condition.notify_all()
+
+    def inject_error(self, status, count=1, retry_after=None, path=None):
+        """Makes the next requests fail.
+
+        Faults are applied in the order they are injected, before the latency
+        and whether or not the request is valid.
+
+        Args:
+            status (Optional[int]): The HTTP status to answer with, or None to
+                close the connection without answering.
+            count (int): How many requests to fail.
+            retry_after (Optional[Union[int, str]]): The value of the
+                ``Retry-After`` header to send, if any.
+            path (Optional[str]): Only fail the requests whose path starts
+                with this, for example ``'/computeMetadata/v1/project/'``.
+        """
+        with self._condition:
+            self._faults.append(_Fault(status, count, retry_after, path))
+
+    def _record(self, path):
+        with self._condition:
+            self.requests.append(path)
+
+    def _take_fault(self, path):
+        with self._condition:
+            for fault in self._faults:
+                if fault.matches(path):
+                    fault.count -= 1
+                    if fault.count <= 0:
+                        self._faults.remove(fault)
+                    return fault
+        return None
+
+    def _lookup(self, segments):
+        """Returns the value at a path and its etag; the value is None if the
+        path does not exist."""
+        with self._condition:
+            value = self._metadata
+            for segment in segments:
+                if not isinstance(value, dict) or segment not in value:
+                    value = None
+                    break
+                value = value[segment]
+            value = copy.deepcopy(value)
+        serialized = json.dumps(value, sort_keys=True)
+        etag = hashlib.sha1(_helpers.to_bytes(serialized)).hexdigest()[:16]
+        return value, etag
+
+    def _wait_for_change(self, segments, etag, timeout_sec):
+        deadline = time.time() + timeout_sec
+        with self._condition:
+            while True:
+                value, current = self._lookup(segments)
+                remaining = deadline - time.time()
+                if current != etag or remaining <= 0 or self._closed:
+                    return value, current
+                self._condition.wait(remaining)
+
+    def _issue_access_token(self, scopes):
+        with self._condition:
+            self._token_count += 1
+            count = self._token_count
+        return {
+            "access_token": "fake-access-token-{}".format(count),
+            "expires_in": self.token_lifetime,
+            "token_type": "Bearer",
+        }
+
+    def _issue_id_token(self, email, audience, full):
+        now = int(time.time())
+        payload = {
+            "aud": audience,
+            "azp": "123456789012345678901",
+            "exp": now + self.token_lifetime,
+            "iat": now,
+            "iss": "https://accounts.google.com",
+            "sub": "123456789012345678901",
+        }
+        if full:
+            payload["email"] = email
+            payload["email_verified"] = True
+        if self._signer is not None:
+            return _helpers.from_bytes(jwt.encode(self._signer, payload))
+
+        header = {"alg": "RS256", "typ": "JWT"}
+        segments = [
+            _helpers.unpadded_urlsafe_b64encode(
+                json.dumps(section, separators=(",", ":")).encode("utf-8")
+            )
+            for section in (header, payload)
+        ]
+        segments.append(_helpers.unpadded_urlsafe_b64encode(b"fake-signature"))
+        return _helpers.from_bytes(b".".join(segments))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Runs a local fake of the Compute Engine metadata server."
+    )
+    parser.add_argument("--host", default="127.0.0.1", help="Address to listen on.")
+    parser.add_argument("--port", type=int, default=0, help="Port to listen on.")
+    parser.add_argument("--project-id", default=_DEFAULT_PROJECT_ID)
+    parser.add_argument("--service-account-email", default=None)
+    parser.add_argument(
+        "--latency", type=float, default=0, help="Seconds to wait per request."
+    )
+    args = parser.parse_args(argv)
+
+    server = FakeMetadataServer(
+        project_id=args.project_id,
+        service_account_email=args.service_account_email,
+        latency=args.latency,
+        host=args.host,
+        port=args.port,
+    )
+    for name, value in sorted(server.environ.items()):
+        print("{}={}".format(name, value))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":  # pragma: NO COVER
+    main()
@@ -0,0 +1,362 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Watches Compute Engine metadata for changes.
+
+Instead of polling the metadata server, a :class:`Watcher` holds a
+``wait_for_change`` long-poll open and calls back as soon as a watched value
+changes. See the `wait for change`_ documentation for details on the protocol.
+
+Subscriptions are multiplexed: all the paths under ``instance/`` are watched
+with a single recursive long-poll, and so are all the paths under
+``project/``, so a watcher never holds more than one connection per top-level
+directory no matter how many paths it watches::
+
+    from google.auth.compute_engine import watch
+
+    def on_change(path, value):
+        print(path, value)
+
+    watcher = watch.Watcher()
+    watcher.subscribe("instance/maintenance-event", on_change)
+    watcher.subscribe("instance/attributes/my-key", on_change)
+    watcher.subscribe("project/attributes/my-key", on_change)
+    ...
+    watcher.close()
+
+The callback is called with the current value when the subscription starts,
+then every time the value changes. Values are decoded from the recursive
+JSON representation of the metadata: directories are mappings and missing
+paths are ``None``.
+
+Callbacks can be coroutine functions; they are scheduled on the event loop
+that was running when the subscription was created.
+
+.. _wait for change: https://cloud.google.com/compute/docs/metadata\
+        /querying-metadata#waitforchange
+"""
+
+import json
+import logging
+import random
+import threading
+
+import six
+from six.moves import http_client
+from six.moves.urllib import parse as urlparse
+
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth.compute_engine import _metadata
+import google.auth.transport._http_client
+
+try:
+    import asyncio
+except ImportError:  # pragma: NO COVER
+    asyncio = None
+
+_LOGGER = logging.getLogger(__name__)
+
+# How long (in seconds) the metadata server holds a long-poll before
+# returning the unchanged value.
+_DEFAULT_TIMEOUT_SEC = 60
+# Extra time allowed for the long-poll response on top of ``timeout_sec``.
+_TIMEOUT_MARGIN = 10
+# Backoff bounds (in seconds) after failed long-polls.
+_INITIAL_BACKOFF = 1.0
+_MAX_BACKOFF = 60.0
+
+# The top-level directories of the metadata server.
+_ROOTS = ("instance", "project")
+
+_UNSET = object()
+
+
+def _camel_case(segment):
+    parts = segment.split("-")
+    return parts[0] + "".join(part.capitalize() for part in parts[1:])
+
+
+def _lookup(tree, segments):
+    """Finds a path in the recursive JSON representation of a directory.
+
+    The recursive representation uses camel case for the names defined by
+    the metadata server (``maintenanceEvent`` for ``maintenance-event``) but
+    keeps user-defined names (attribute keys) as they are.
+    """
+    value = tree
+    for segment in segments:
+        if not isinstance(value, dict):
+            return None
+        if segment in value:
+            value = value[segment]
+        else:
+            value = value.get(_camel_case(segment))
+    return value
+
+
+class Subscription(object):
+    """A path watched by a :class:`Watcher`.
+
+    Use :meth:`Watcher.subscribe` to create subscriptions.
+    """
+
+    def __init__(self, watcher, path, callback, loop):
+        self._watcher = watcher
+        self.path = path
+        segments = [segment for segment in (path or "").split("/") if segment]
+        if not segments:
+            raise ValueError("The path to watch is empty.")
+        if segments[0] not in _ROOTS:
+            raise ValueError(
+                "The path to watch must start with one of {}, got {!r}.".format(
+                    ", ".join(_ROOTS), path
+                )
+            )
+        self._root = segments[0]
+        self._segments = segments[1:]
+        self._callback = callback
+        self._loop = loop
+        # Reentrant so that a callback can cancel its own subscription.
+        self._lock = threading.RLock()
+        self._value = _UNSET
+        self._version = -1
+        self._cancelled = False
+
+    def cancel(self):
+        """Stops watching the path.
+
+        A callback already running is not interrupted, but no other callback
+        is started once this returns.
+        """
+        self._cancelled = True
+        self._watcher._unsubscribe(self)
+
+    def _deliver(self, tree, version):
+        """Calls back with the path's value in a version of the directory
+        tree, unless it was already delivered or is unchanged."""
+        value = _lookup(tree, self._segments)
+        with self._lock:
+            if self._cancelled or version <= self._version:
+                return
+            self._version = version
+            if value == self._value:
+                return
+            self._value = value
+
+            if self._loop is not None:
+                future = asyncio.run_coroutine_threadsafe(
+                    self._callback(self.path, value), self._loop
+                )
+                future.add_done_callback(self._log_async_failure)
+                return
+
+            try:
+                self._callback(self.path, value)
+            except Exception:  # pylint: disable=broad-except
+                _LOGGER.exception("Metadata watch callback for %s failed", self.path)
+
+    def _log_async_failure(self, future):
+        if not future.cancelled() and future.exception() is not None:
+            _LOGGER.error(
+                "Metadata watch callback for %s failed",
+                self.path,
+                exc_info=future.exception(),
+            )
+
+
+class _DirectoryWatch(object):
+    """Watches a top-level metadata directory with a single long-poll on a
+    background thread, on behalf of all the subscriptions under it."""
+
+    def __init__(self, watcher, root):
+        self._watcher = watcher
+        self.root = root
+        self.subscriptions = []
+        self.tree = None
+        self.version = 0
+        self._url = urlparse.urljoin(watcher._metadata_root, root + "/")
+        self._thread = threading.Thread(
+            target=self._run, name="google-auth-metadata-watch-" + root
+        )
+        self._thread.daemon = True
+
+    def start(self):
+        self._thread.start()
+
+    def _poll(self, etag):
+        params = {"recursive": "true"}
+        timeout = _metadata._METADATA_DEFAULT_TIMEOUT
+        if etag is not None:
+            params["wait_for_change"] = "true"
+            params["last_etag"] = etag
+            params["timeout_sec"] = str(self._watcher._timeout_sec)
+            timeout = self._watcher._timeout_sec + _TIMEOUT_MARGIN
+
+        url = _helpers.update_query(self._url, params)
+        response = self._watcher._request(
+            url=url, method="GET", headers=_metadata._METADATA_HEADERS, timeout=timeout
+        )
+        if response.status != http_client.OK:
+            raise exceptions.TransportError(
+                "Failed to watch {} on the Google Compute Engine metadata "
+                "service. Status: {} Response:\n{}".format(
+                    url, response.status, response.data
+                ),
+                response,
+            )
+
+        try:
+            tree = json.loads(_helpers.from_bytes(response.data))
+        except ValueError as caught_exc:
+            new_exc = exceptions.TransportError(
+                "Received invalid JSON from the Google Compute Engine "
+                "metadata service: {:.20}".format(_helpers.from_bytes(response.data))
+            )
+            six.raise_from(new_exc, caught_exc)
+        return tree, response.headers.get("etag")
+
+    def _run(self):
+        watcher = self._watcher
+        etag = None
+        failures = 0
+        while not watcher._closed.is_set():
+            with watcher._lock:
+                if not self.subscriptions:
+                    del watcher._directories[self.root]
+                    return
+
+            try:
+                tree, etag = self._poll(etag)
+            except exceptions.TransportError as caught_exc:
+                etag = None
+                delay = random.uniform(
+                    0, min(_MAX_BACKOFF, _INITIAL_BACKOFF * 2 ** failures)
+                )
+                failures += 1
+                _LOGGER.warning(
+                    "Watching %s on the Compute Engine metadata server failed "
+                    "%s times, retrying in %.1fs. Reason: %s",
+                    self.root,
+                    failures,
+                    delay,
+                    caught_exc,
+                )
+                watcher._closed.wait(delay)
+                continue
+
+            failures = 0
+            with watcher._lock:
+                self.tree = tree
+                self.version += 1
+                version = self.version
+                subscriptions = list(self.subscriptions)
+
+            for subscription in subscriptions:
+                subscription._deliver(tree, version)
+
+
+class Watcher(object):
+    """Watches metadata server paths for changes.
+
+    Args:
+        request (Optional[google.auth.transport.Request]): A callable used to
+            make HTTP requests. It must accept a ``timeout`` argument. Defaults
+            to the ``http.client`` based transport.
+        timeout_sec (int): How long the metadata server holds each long-poll
+            open before returning an unchanged value.
+        root (Optional[str]): The full path to the metadata server root.
+            Defaults to the root configured by the environment.
+    """
+
+    def __init__(
+        self,
+        request=None,
+        timeout_sec=_DEFAULT_TIMEOUT_SEC,
+        root=None,
+    ):
+        if request is None:
+            request = google.auth.transport._http_client.Request()
+        self._request = request
+        self._timeout_sec = timeout_sec
+        self._metadata_root = _metadata._METADATA_ROOT if root is None else root
+        self._lock = threading.Lock()
+        self._closed = threading.Event()
+        self._directories = {}
+
+    def subscribe(self, path, callback):
+        """Starts watching a path.
+
+        Args:
+            path (str): The path to watch, for example
+                ``'instance/attributes/my-key'``.
+            callback (Callable[[str, Any], None]): Called with the path and
+                its value, first with the current value and then on every
+                change. It is called on a background thread; if it is a
+                coroutine function, it is scheduled on the current event loop
+                instead.
+
+        Returns:
+            Subscription: The subscription, which can be cancelled.
+
+        Raises:
+            ValueError: If the path is empty, isn't under ``instance/`` or
+                ``project/``, or the watcher is closed.
+        """
+        loop = None
+        if asyncio is not None and asyncio.iscoroutinefunction(callback):
+            loop = asyncio.get_event_loop()
+
+        subscription = Subscription(self, path, callback, loop)
+        with self._lock:
+            if self._closed.is_set():
+                raise ValueError("The watcher is closed.")
+            directory = self._directories.get(subscription._root)
+            if directory is None:
+                directory = _DirectoryWatch(self, subscription._root)
+                self._directories[subscription._root] = directory
+                directory.start()
+            directory.subscriptions.append(subscription)
+            tree, version = directory.tree, directory.version
+
+        # The directory is already being watched: deliver the value known so
+        # far instead of waiting for the next change.
+        if tree is not None:
+            subscription._deliver(tree, version)
+        return subscription
+
+    def _unsubscribe(self, subscription):
+        with self._lock:
+            directory = self._directories.get(subscription._root)
+            if directory is not None and subscription in directory.subscriptions:
+                directory.subscriptions.remove(subscription)
+
+    def close(self):
+        """Stops watching all paths.
+
+        A long-poll in flight is abandoned. A callback already running is not
+        interrupted, but no other callback is started once this returns.
+        """
+        with self._lock:
+            self._closed.set()
+            for directory in self._directories.values():
+                for subscription in directory.subscriptions:
+                    subscription._cancelled = True
+                del directory.subscriptions[:]
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
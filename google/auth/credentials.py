@@ -20,6 +20,7 @@ import abc
 import six
 
 from google.auth import _helpers
+from google.auth import instrumentation
 
 
 @six.add_metaclass(abc.ABCMeta)
@@ -130,7 +131,7 @@ class Credentials(object):
         # (Subclasses may use these arguments to ascertain information about
         # the http request.)
         if not self.valid:
-            self.refresh(request)
+            instrumentation._traced_refresh(self, request)
         self.apply(headers)
 
 
@@ -49,6 +49,8 @@ Cloud services do not support this feature.
 """
 
 import datetime
+import json
+import threading
 
 import six
 
@@ -468,8 +470,15 @@ class Credentials(credentials.CredentialsWithQuotaProject):
 
     @_helpers.copy_docstring(credentials.Credentials)
     def refresh(self, request):
-        # Generate an access token from the source credentials.
-        self._source_credentials.refresh(request)
+        # Generate an access token from the source credentials, unless their
+        # current token can still be exchanged.
+        if not _source_token_reusable(self._source_credentials):
+            self._source_credentials.refresh(request)
+        self._exchange_token(request)
+
+    def _exchange_token(self, request):
+        """Exchanges the current token of the source credentials for a
+        downscoped access token."""
         now = _helpers.utcnow()
         # Exchange the access token for a downscoped access token.
         response_data = self._sts_client.exchange_token(
@@ -499,3 +508,116 @@ class Credentials(credentials.CredentialsWithQuotaProject):
             self._credential_access_boundary,
             quota_project_id=quota_project_id,
         )
+
+
+def _source_token_reusable(source_credentials):
+    """Whether the current token of the source credentials can be exchanged
+    without refreshing them. Credentials without an expiry are always
+    "valid", so their token is refreshed as it may have been revoked."""
+    return source_credentials.valid and source_credentials.expiry is not None
+
+
+class _BoundaryCredentials(object):
+    """The downscoped credentials of one Credential Access Boundary."""
+
+    def __init__(self, credentials):
+        # Held while refreshing, so that concurrent refreshes are coalesced.
+        self.lock = threading.Lock()
+        self.credentials = credentials
+
+
+class CredentialsPool(object):
+    """Downscopes one source credential to many Credential Access Boundaries.
+
+    A token broker serving many token consumers, each with its own Credential
+    Access Boundary, can get their downscoped tokens from a pool. The source
+    credentials are shared by all the boundaries and only refreshed when their
+    token expires, or on every exchange if their token has no expiry. The
+    downscoped token of each boundary is kept until it expires, and concurrent
+    requests for the token of a boundary share a single exchange.
+
+    Boundaries are identified by their :meth:`CredentialAccessBoundary.to_json`
+    representation, so equal boundaries built separately share a token. The
+    pool is thread-safe.
+    """
+
+    def __init__(self, source_credentials, quota_project_id=None):
+        """Instantiates a pool of downscoped credentials.
+
+        Args:
+            source_credentials (google.auth.credentials.Credentials): The source
+                credentials to be downscoped.
+            quota_project_id (Optional[str]): The optional quota project ID of
+                the downscoped credentials.
+        """
+        self._source_credentials = source_credentials
+        self._quota_project_id = quota_project_id
+        self._source_lock = threading.Lock()
+        self._lock = threading.Lock()
+        self._boundaries = {}
+
+    def _get_boundary(self, credential_access_boundary):
+        key = json.dumps(credential_access_boundary.to_json(), sort_keys=True)
+        boundary = self._boundaries.get(key)
+        if boundary is None:
+            with self._lock:
+                boundary = self._boundaries.get(key)
+                if boundary is None:
+                    boundary = self._boundaries[key] = _BoundaryCredentials(
+                        Credentials(
+                            self._source_credentials,
+                            credential_access_boundary,
+                            quota_project_id=self._quota_project_id,
+                        )
+                    )
+        return boundary
+
+    def get_credentials(self, credential_access_boundary):
+        """Returns the downscoped credentials of a Credential Access Boundary.
+
+        Args:
+            credential_access_boundary (google.auth.downscoped.CredentialAccessBoundary):
+                The Credential Access Boundary.
+
+        Returns:
+            google.auth.downscoped.Credentials: The downscoped credentials,
+                shared by all the equal boundaries.
+        """
+        return self._get_boundary(credential_access_boundary).credentials
+
+    def get_token(self, request, credential_access_boundary):
+        """Returns a valid downscoped access token, exchanging one if the
+        token of the boundary is missing or expired.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+            credential_access_boundary (google.auth.downscoped.CredentialAccessBoundary):
+                The Credential Access Boundary.
+
+        Returns:
+            Tuple[str, Optional[datetime]]: The downscoped access token and its
+                expiration.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If the source credentials
+                return an error on token refresh.
+            google.auth.exceptions.OAuthError: If the STS token exchange
+                endpoint returned an error.
+        """
+        boundary = self._get_boundary(credential_access_boundary)
+        downscoped_credentials = boundary.credentials
+        if not downscoped_credentials.valid:
+            with boundary.lock:
+                # Another thread may have refreshed them while this one waited.
+                if not downscoped_credentials.valid:
+                    with self._source_lock:
+                        if not _source_token_reusable(self._source_credentials):
+                            self._source_credentials.refresh(request)
+                    downscoped_credentials._exchange_token(request)
+        return downscoped_credentials.token, downscoped_credentials.expiry
+
+    def clear(self):
+        """Drops the downscoped credentials of all the boundaries."""
+        with self._lock:
+            self._boundaries.clear()
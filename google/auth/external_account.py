@@ -32,6 +32,7 @@ import copy
 import datetime
 import json
 import re
+import threading
 
 import six
 from urllib3.util import parse_url
@@ -53,6 +54,89 @@ _STS_REQUESTED_TOKEN_TYPE = "urn:ietf:params:oauth:token-type:access_token"
 _CLOUD_RESOURCE_MANAGER = "https://cloudresourcemanager.googleapis.com/v1/projects/"
 
 
+def _canonical_scopes(scopes):
+    """Returns a hashable, order-independent form of a set of scopes."""
+    return tuple(sorted(set(scopes or ())))
+
+
+class _StsTokens(object):
+    """The latest STS token for one external account configuration."""
+
+    def __init__(self):
+        # Held while exchanging, so that concurrent exchanges are coalesced.
+        self.lock = threading.Lock()
+        # The token and its expiry, read and replaced together.
+        self.token = (None, None)
+
+
+class _StsTokenCache(object):
+    """Shares the access tokens returned by STS within the process.
+
+    Tokens are cached by STS endpoint, client, audience, subject token type,
+    credential source and canonical set of scopes. All the credentials for the
+    same workload identity, such as the copies made by
+    :meth:`Credentials.with_scopes` and the source credentials of every
+    impersonated service account, are then served by a single exchange.
+    Concurrent requests for a token that isn't cached share a single
+    exchange.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._tokens = {}
+
+    def _get_tokens(self, key):
+        tokens = self._tokens.get(key)
+        if tokens is None:
+            with self._lock:
+                tokens = self._tokens.setdefault(key, _StsTokens())
+        return tokens
+
+    @staticmethod
+    def _usable(token, expiry, stale_token):
+        return (
+            token is not None
+            and token != stale_token
+            and _helpers.utcnow() < expiry - _helpers.REFRESH_THRESHOLD
+        )
+
+    def get_token(self, key, exchange, stale_token=None):
+        """Gets an access token, exchanging one if none is cached.
+
+        Args:
+            key (Hashable): Identifies the configuration of the exchange.
+            exchange (Callable[[], Tuple[str, datetime]]): Exchanges a new
+                token, returning it with its expiration.
+            stale_token (Optional[str]): A token the caller already has and
+                wants replaced, for example after it was rejected. It is not
+                returned even if it is still cached.
+
+        Returns:
+            Tuple[str, datetime]: The access token and its expiration.
+        """
+        tokens = self._get_tokens(key)
+        token, expiry = tokens.token
+        if self._usable(token, expiry, stale_token):
+            return token, expiry
+
+        with tokens.lock:
+            # Another thread may have exchanged a token while this one waited.
+            token, expiry = tokens.token
+            if self._usable(token, expiry, stale_token):
+                return token, expiry
+
+            tokens.token = exchange()
+            return tokens.token
+
+    def clear(self):
+        """Drops all the cached tokens."""
+        with self._lock:
+            self._tokens.clear()
+
+
+_sts_token_cache = _StsTokenCache()
+
+
 @six.add_metaclass(abc.ABCMeta)
 class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
     """Base class for all external account credentials.
@@ -61,6 +145,12 @@ class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
     credentials for Google access token and authorizing requests to Google APIs.
     The base class implements the common logic for exchanging external account
     credentials for Google access tokens.
+
+    The access tokens returned by STS are shared by all the credentials in the
+    process with the same configuration and set of scopes. Copies made with
+    :meth:`with_scopes` or :meth:`with_quota_project`, and credentials
+    impersonating different service accounts from the same workload identity,
+    don't each retrieve a subject token and exchange it.
     """
 
     def __init__(
@@ -331,25 +421,44 @@ class Credentials(credentials.Scoped, credentials.CredentialsWithQuotaProject):
             self.token = self._impersonated_credentials.token
             self.expiry = self._impersonated_credentials.expiry
         else:
-            now = _helpers.utcnow()
-            additional_options = None
-            # Do not pass workforce_pool_user_project when client authentication
-            # is used. The client ID is sufficient for determining the user project.
-            if self._workforce_pool_user_project and not self._client_id:
-                additional_options = {"userProject": self._workforce_pool_user_project}
-            response_data = self._sts_client.exchange_token(
-                request=request,
-                grant_type=_STS_GRANT_TYPE,
-                subject_token=self.retrieve_subject_token(request),
-                subject_token_type=self._subject_token_type,
-                audience=self._audience,
-                scopes=scopes,
-                requested_token_type=_STS_REQUESTED_TOKEN_TYPE,
-                additional_options=additional_options,
+            self.token, self.expiry = _sts_token_cache.get_token(
+                self._sts_token_key(scopes),
+                lambda: self._exchange_token(request, scopes),
+                stale_token=self.token,
             )
-            self.token = response_data.get("access_token")
-            lifetime = datetime.timedelta(seconds=response_data.get("expires_in"))
-            self.expiry = now + lifetime
+
+    def _sts_token_key(self, scopes):
+        """Returns what identifies the tokens STS returns to these
+        credentials."""
+        return (
+            self._token_url,
+            self._client_id,
+            self._audience,
+            self._subject_token_type,
+            json.dumps(self._credential_source, sort_keys=True),
+            self._workforce_pool_user_project,
+            _canonical_scopes(scopes),
+        )
+
+    def _exchange_token(self, request, scopes):
+        now = _helpers.utcnow()
+        additional_options = None
+        # Do not pass workforce_pool_user_project when client authentication
+        # is used. The client ID is sufficient for determining the user project.
+        if self._workforce_pool_user_project and not self._client_id:
+            additional_options = {"userProject": self._workforce_pool_user_project}
+        response_data = self._sts_client.exchange_token(
+            request=request,
+            grant_type=_STS_GRANT_TYPE,
+            subject_token=self.retrieve_subject_token(request),
+            subject_token_type=self._subject_token_type,
+            audience=self._audience,
+            scopes=scopes,
+            requested_token_type=_STS_REQUESTED_TOKEN_TYPE,
+            additional_options=additional_options,
+        )
+        lifetime = datetime.timedelta(seconds=response_data.get("expires_in"))
+        return response_data.get("access_token"), now + lifetime
 
     @_helpers.copy_docstring(credentials.CredentialsWithQuotaProject)
     def with_quota_project(self, quota_project_id):
@@ -27,6 +27,7 @@ from six.moves import http_client
 from google.auth import _helpers
 from google.auth import crypt
 from google.auth import exceptions
+from google.auth import instrumentation
 
 _IAM_API_ROOT_URI = "https://iamcredentials.googleapis.com/v1"
 _SIGN_BLOB_URI = _IAM_API_ROOT_URI + "/projects/-/serviceAccounts/{}:signBlob?alt=json"
@@ -95,6 +96,7 @@ class Signer(crypt.Signer):
         return None
 
     @_helpers.copy_docstring(crypt.Signer)
+    @instrumentation._traced("google.auth.iam.sign")
     def sign(self, message):
         response = self._make_signing_request(message)
         return base64.b64decode(response["signedBlob"])
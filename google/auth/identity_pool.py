@@ -38,17 +38,108 @@ try:
 # Python 2.7 compatibility
 except ImportError:  # pragma: NO COVER
     from collections import Mapping
+import datetime
+import errno
 import io
 import json
-import os
+import logging
+import weakref
 
+import six
+from six.moves import http_client
+
+from google.auth import _file_watcher
 from google.auth import _helpers
 from google.auth import exceptions
 from google.auth import external_account
+from google.auth import jwt
+
+_LOGGER = logging.getLogger(__name__)
+
+# How long before their ``exp`` subject tokens from URLs are retrieved again,
+# so that they are still valid when they are exchanged.
+_SUBJECT_TOKEN_EXPIRY_MARGIN = datetime.timedelta(minutes=1)
+
+
+class _UrlSubjectToken(object):
+    """A subject token retrieved from a URL, with what is needed to reuse it
+    or to revalidate it with a conditional request."""
+
+    def __init__(self, token, etag, last_modified, fresh_until):
+        self.token = token
+        self.etag = etag
+        self.last_modified = last_modified
+        self.fresh_until = fresh_until
+
+
+def _get_header(headers, name):
+    """Returns a response header, looked up case-insensitively."""
+    for key, value in six.iteritems(headers or {}):
+        if key.lower() == name:
+            return value
+    return None
+
+
+def _subject_token_expiry(token):
+    """Returns the ``exp`` of a JWT subject token, or None if the token is
+    not a JWT or has no expiry."""
+    try:
+        _, payload, _, _ = jwt._unverified_decode(token)
+        return datetime.datetime.utcfromtimestamp(payload["exp"])
+    except (ValueError, TypeError, KeyError, AttributeError, OverflowError):
+        return None
+
+
+def _fresh_until(token, headers, now):
+    """Returns until when a subject token retrieved from a URL can be reused
+    without requesting it again.
+
+    The ``Cache-Control`` of the response bounds it, and so does the ``exp``
+    of JWT subject tokens. A response without ``Cache-Control`` can be
+    reused until its subject token expires.
+
+    Returns:
+        Optional[datetime.datetime]: The time, or None if the response must
+            not be cached at all.
+    """
+    max_age = None
+    no_cache = False
+    for directive in (_get_header(headers, "cache-control") or "").split(","):
+        directive = directive.strip().lower()
+        if directive == "no-store":
+            return None
+        elif directive == "no-cache":
+            no_cache = True
+        elif directive.startswith("max-age="):
+            try:
+                max_age = int(directive[len("max-age=") :])
+            except ValueError:
+                pass
+
+    if no_cache:
+        return now
+    expiry = _subject_token_expiry(token)
+    if expiry is not None:
+        expiry -= _SUBJECT_TOKEN_EXPIRY_MARGIN
+    if max_age is None:
+        return expiry if expiry is not None else now
+    fresh_until = now + datetime.timedelta(seconds=max_age)
+    return fresh_until if expiry is None else min(fresh_until, expiry)
 
 
 class Credentials(external_account.Credentials):
-    """External account credentials sourced from files and URLs."""
+    """External account credentials sourced from files and URLs.
+
+    File sources are read again only when the file changes, and the subject
+    token parsed from them is kept until then. To exchange a new subject
+    token as soon as the file is rotated, rather than on the next refresh,
+    call :meth:`watch_credential_source`.
+
+    Subject tokens from URL sources are reused as allowed by the
+    ``Cache-Control`` of the response and, for JWTs, until shortly before
+    their ``exp``. They are then revalidated with a conditional request when
+    the response had an ``ETag`` or ``Last-Modified`` header.
+    """
 
     def __init__(
         self,
@@ -166,6 +257,12 @@ class Credentials(external_account.Credentials):
             else:
                 self._credential_source_field_name = None
 
+        # The content of the credential source file and the subject token
+        # parsed from it.
+        self._subject_token_cache = (None, None)
+        # The _UrlSubjectToken of URL sources.
+        self._url_subject_token = None
+
         if self._credential_source_file and self._credential_source_url:
             raise ValueError(
                 "Ambiguous credential_source. 'file' is mutually exclusive with 'url'."
@@ -177,30 +274,133 @@ class Credentials(external_account.Credentials):
 
     @_helpers.copy_docstring(external_account.Credentials)
     def retrieve_subject_token(self, request):
-        return self._parse_token_data(
-            self._get_token_data(request),
-            self._credential_source_format_type,
-            self._credential_source_field_name,
-        )
+        if self._credential_source_url:
+            return self._get_url_subject_token(request)
+
+        token_data = self._get_file_data(self._credential_source_file)
+        # The watcher returns the same content object until the file changes.
+        content, token = self._subject_token_cache
+        if token_data[0] is not content:
+            token = self._parse_token_data(
+                token_data,
+                self._credential_source_format_type,
+                self._credential_source_field_name,
+            )
+            self._subject_token_cache = (token_data[0], token)
+        return token
 
-    def _get_token_data(self, request):
-        if self._credential_source_file:
-            return self._get_file_data(self._credential_source_file)
-        else:
-            return self._get_url_data(
-                request, self._credential_source_url, self._credential_source_headers
+    def watch_credential_source(self, request=None):
+        """Refreshes the credentials as soon as the subject token in the
+        credential source file changes.
+
+        The file is watched on a background thread, with inotify on Linux and
+        by polling its status elsewhere. Copies of the credentials, such as
+        the ones returned by :meth:`with_scopes`, are not refreshed.
+
+        Args:
+            request (Optional[google.auth.transport.Request]): A callable used
+                to make HTTP requests from the background thread. If not
+                provided, the credentials are expired instead, so that the
+                next request refreshes them.
+
+        Raises:
+            ValueError: If the credentials are not sourced from a file.
+        """
+        if not self._credential_source_file:
+            raise ValueError("Only file-sourced credentials can be watched.")
+
+        watcher = _file_watcher.get_watcher(self._credential_source_file)
+        credentials_ref = weakref.ref(self)
+
+        def on_change(content):
+            credentials = credentials_ref()
+            if credentials is None:
+                watcher.unsubscribe(on_change)
+            else:
+                credentials._on_credential_source_change(request, content)
+
+        watcher.subscribe(on_change)
+
+    def _on_credential_source_change(self, request, content):
+        try:
+            token = self._parse_token_data(
+                (content, self._credential_source_file),
+                self._credential_source_format_type,
+                self._credential_source_field_name,
+            )
+        except exceptions.RefreshError:
+            # The file may be partially written; the next change completes it.
+            return
+
+        if token == self._subject_token_cache[1]:
+            return
+        if request is None:
+            if self.token is not None:
+                self.expiry = _helpers.utcnow()
+            return
+        try:
+            self.refresh(request)
+        except exceptions.GoogleAuthError as caught_exc:
+            # The next request retries the refresh.
+            _LOGGER.warning(
+                "Refreshing credentials after the subject token changed failed: %s",
+                caught_exc,
             )
 
     def _get_file_data(self, filename):
-        if not os.path.exists(filename):
-            raise exceptions.RefreshError("File '{}' was not found.".format(filename))
+        try:
+            return _file_watcher.get_watcher(filename).read(), filename
+        except (IOError, OSError) as caught_exc:
+            if caught_exc.errno != errno.ENOENT:
+                raise
+            new_exc = exceptions.RefreshError(
+                "File '{}' was not found.".format(filename)
+            )
+            six.raise_from(new_exc, caught_exc)
+
+    def _get_url_subject_token(self, request):
+        cached = self._url_subject_token
+        if cached is not None and _helpers.utcnow() < cached.fresh_until:
+            return cached.token
+
+        headers = self._credential_source_headers
+        if cached is not None and (cached.etag or cached.last_modified):
+            headers = dict(headers or {})
+            if cached.etag:
+                headers["If-None-Match"] = cached.etag
+            if cached.last_modified:
+                headers["If-Modified-Since"] = cached.last_modified
+
+        response = request(
+            url=self._credential_source_url, method="GET", headers=headers
+        )
 
-        with io.open(filename, "r", encoding="utf-8") as file_obj:
-            return file_obj.read(), filename
+        if cached is not None and response.status == http_client.NOT_MODIFIED:
+            token = cached.token
+            etag = _get_header(response.headers, "etag") or cached.etag
+            last_modified = (
+                _get_header(response.headers, "last-modified")
+                or cached.last_modified
+            )
+        else:
+            token = self._parse_token_data(
+                self._get_url_data(response, self._credential_source_url),
+                self._credential_source_format_type,
+                self._credential_source_field_name,
+            )
+            etag = _get_header(response.headers, "etag")
+            last_modified = _get_header(response.headers, "last-modified")
 
-    def _get_url_data(self, request, url, headers):
-        response = request(url=url, method="GET", headers=headers)
+        fresh_until = _fresh_until(token, response.headers, _helpers.utcnow())
+        if fresh_until is None:
+            self._url_subject_token = None
+        else:
+            self._url_subject_token = _UrlSubjectToken(
+                token, etag, last_modified, fresh_until
+            )
+        return token
 
+    def _get_url_data(self, response, url):
         # support both string and bytes type response.data
         response_body = (
             response.data.decode("utf-8")
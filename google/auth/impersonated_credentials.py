@@ -29,6 +29,7 @@ import base64
 import copy
 from datetime import datetime
 import json
+import threading
 
 import six
 from six.moves import http_client
@@ -63,6 +64,10 @@ _DEFAULT_TOKEN_LIFETIME_SECS = 3600  # 1 hour in seconds
 
 _DEFAULT_TOKEN_URI = "https://oauth2.googleapis.com/token"
 
+# Guards the creation of the signing sessions. It is shared by all the
+# credentials, so that they hold no lock and can be pickled.
+_SIGNING_SESSION_LOCK = threading.Lock()
+
 
 def _make_iam_token_request(
     request, principal, headers, body, iam_endpoint_override=None
@@ -237,6 +242,21 @@ class Credentials(
         self.expiry = _helpers.utcnow()
         self._quota_project_id = quota_project_id
         self._iam_endpoint_override = iam_endpoint_override
+        # The session signing with the source credentials, created on the
+        # first signature and kept to reuse its connections.
+        self._signing_session = None
+
+    def __getstate__(self):
+        """Excludes the signing session, which can't be pickled."""
+        state_dict = self.__dict__.copy()
+        state_dict["_signing_session"] = None
+        return state_dict
+
+    def __setstate__(self, d):
+        """Credentials pickled with older versions of the class do not have
+        a signing session."""
+        self.__dict__.update(d)
+        self._signing_session = None
 
     @_helpers.copy_docstring(credentials.Credentials)
     def refresh(self, request):
@@ -274,9 +294,22 @@ class Credentials(
             iam_endpoint_override=self._iam_endpoint_override,
         )
 
-    def sign_bytes(self, message):
+    def _get_signing_session(self):
+        """Returns the session signing with the source credentials.
+
+        The session is shared by all the signatures, and by the threads
+        signing concurrently, so that they reuse its connections to the IAM
+        Credentials API.
+        """
         from google.auth.transport.requests import AuthorizedSession
 
+        if self._signing_session is None:
+            with _SIGNING_SESSION_LOCK:
+                if self._signing_session is None:
+                    self._signing_session = AuthorizedSession(self._source_credentials)
+        return self._signing_session
+
+    def sign_bytes(self, message):
         iam_sign_endpoint = _IAM_SIGN_ENDPOINT.format(self._target_principal)
 
         body = {
@@ -286,7 +319,7 @@ class Credentials(
 
         headers = {"Content-Type": "application/json"}
 
-        authed_session = AuthorizedSession(self._source_credentials)
+        authed_session = self._get_signing_session()
 
         response = authed_session.post(
             url=iam_sign_endpoint, headers=headers, json=body
@@ -299,6 +332,37 @@ class Credentials(
 
         return base64.b64decode(response.json()["signedBlob"])
 
+    def sign_bytes_many(
+        self, messages, max_concurrency=_helpers.DEFAULT_MAX_CONCURRENCY
+    ):
+        """Signs many messages concurrently.
+
+        The messages are signed by a bounded number of worker threads, sharing
+        the connections of the signing session. The first message is signed
+        before starting the threads, so that the source credentials are
+        refreshed once rather than by every thread.
+
+        Args:
+            messages (Sequence[bytes]): The messages to sign.
+            max_concurrency (int): The maximum number of signatures in flight.
+
+        Returns:
+            Sequence[bytes]: The signature of each message, in the order
+                given.
+
+        Raises:
+            ValueError: If ``max_concurrency`` is less than one.
+            google.auth.exceptions.TransportError: If a message can't be
+                signed. The messages not signed yet are then skipped.
+        """
+        return _helpers.map_concurrently(
+            self.sign_bytes,
+            messages,
+            max_concurrency,
+            "google-auth-sign-bytes",
+            first_serially=True,
+        )
+
     @property
     def signer_email(self):
         return self._target_principal
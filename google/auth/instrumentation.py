@@ -0,0 +1,256 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tracing and metrics hooks for token acquisition.
+
+The library reports the duration of the operations involved in getting a
+token: credential refreshes, token endpoint requests, metadata server
+requests, STS exchanges, IAM ``signBlob`` calls and 401-triggered refresh
+retries in :class:`google.auth.transport.requests.AuthorizedSession`.
+
+Nothing is reported until an :class:`Instrumentation` is installed::
+
+    from google.auth import instrumentation
+
+    class PrintInstrumentation(instrumentation.Instrumentation):
+        def record(self, name, duration, attributes, error=None):
+            print(name, duration, attributes, error)
+
+    instrumentation.set_instrumentation(PrintInstrumentation())
+
+To export spans and a duration histogram through OpenTelemetry, install
+``google-auth[opentelemetry]`` and use :class:`OpenTelemetryInstrumentation`::
+
+    instrumentation.set_instrumentation(
+        instrumentation.OpenTelemetryInstrumentation())
+
+Operation names reported by the library:
+
+* ``google.auth.credentials.refresh``
+* ``google.auth.transport.refresh_retry``
+* ``google.oauth2.token_endpoint_request``
+* ``google.oauth2.sts.exchange_token``
+* ``google.oauth2.sts.exchange_tokens``
+* ``google.auth.compute_engine.metadata.get``
+* ``google.auth.compute_engine.metadata.ping``
+* ``google.auth.compute_engine.metadata.retry``, the delay before retrying a
+  metadata server request, with the ``attempt`` number
+* ``google.auth.iam.sign``
+"""
+
+import contextlib
+import functools
+import time
+
+import six
+
+from google.auth import version
+
+_instrumentation = None
+
+# Durations are measured on a clock that doesn't jump with the wall clock.
+try:
+    _perf_counter = time.perf_counter
+except AttributeError:  # pragma: NO COVER
+    # Python 2
+    _perf_counter = time.time
+
+
+class Instrumentation(object):
+    """Receives the timing of token acquisition operations.
+
+    Subclasses usually only override :meth:`record`. Override
+    :meth:`start_span` to wrap the operations in something else, such as a
+    tracing span.
+    """
+
+    def start_span(self, name, attributes):
+        """Starts timing an operation.
+
+        Args:
+            name (str): The name of the operation.
+            attributes (Mapping[str, str]): Attributes describing the
+                operation.
+
+        Returns:
+            ContextManager: A context manager wrapping the operation.
+        """
+        return _TimedSpan(self, name, attributes)
+
+    def record(self, name, duration, attributes, error=None):
+        """Records a finished operation.
+
+        Args:
+            name (str): The name of the operation.
+            duration (float): How long the operation took, in seconds.
+            attributes (Mapping[str, str]): Attributes describing the
+                operation.
+            error (Optional[Exception]): The error the operation raised, if
+                any.
+        """
+
+
+class _TimedSpan(object):
+    def __init__(self, instrumentation, name, attributes):
+        self._instrumentation = instrumentation
+        self._name = name
+        self._attributes = attributes
+        self._start = None
+
+    def __enter__(self):
+        self._start = _perf_counter()
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self._instrumentation.record(
+            self._name, _perf_counter() - self._start, self._attributes, exc_value
+        )
+        return False
+
+
+class _NoOpSpan(object):
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        return False
+
+
+_NO_OP_SPAN = _NoOpSpan()
+
+
+class OpenTelemetryInstrumentation(Instrumentation):
+    """Reports operations as OpenTelemetry spans and a duration histogram.
+
+    The histogram is named ``google.auth.operation.duration`` and carries the
+    operation name in its ``operation`` attribute.
+
+    Args:
+        tracer_provider (Optional[opentelemetry.trace.TracerProvider]): The
+            tracer provider to use. Defaults to the global one.
+        meter_provider (Optional[opentelemetry.metrics.MeterProvider]): The
+            meter provider to use. Defaults to the global one.
+
+    Raises:
+        ImportError: If the ``opentelemetry-api`` package is not installed.
+    """
+
+    def __init__(self, tracer_provider=None, meter_provider=None):
+        try:
+            from opentelemetry import metrics  # type: ignore
+            from opentelemetry import trace  # type: ignore
+        except ImportError as caught_exc:
+            six.raise_from(
+                ImportError(
+                    "OpenTelemetry is not installed, please install the "
+                    "google-auth[opentelemetry] extra to use "
+                    "OpenTelemetryInstrumentation."
+                ),
+                caught_exc,
+            )
+
+        self._tracer = trace.get_tracer(
+            __name__, version.__version__, tracer_provider=tracer_provider
+        )
+        meter = metrics.get_meter(
+            __name__, version.__version__, meter_provider=meter_provider
+        )
+        self._histogram = meter.create_histogram(
+            "google.auth.operation.duration",
+            unit="s",
+            description="Duration of google-auth token acquisition operations.",
+        )
+
+    @contextlib.contextmanager
+    def start_span(self, name, attributes):
+        with self._tracer.start_as_current_span(name, attributes=attributes):
+            with super(OpenTelemetryInstrumentation, self).start_span(
+                name, attributes
+            ):
+                yield
+
+    def record(self, name, duration, attributes, error=None):
+        metric_attributes = dict(attributes, operation=name)
+        if error is not None:
+            metric_attributes["error"] = type(error).__name__
+        self._histogram.record(duration, attributes=metric_attributes)
+
+
+def set_instrumentation(instrumentation):
+    """Installs the instrumentation receiving operation timings.
+
+    Args:
+        instrumentation (Optional[Instrumentation]): The instrumentation to
+            use, or None to disable instrumentation.
+    """
+    global _instrumentation
+    _instrumentation = instrumentation
+
+
+def get_instrumentation():
+    """Returns the installed instrumentation.
+
+    Returns:
+        Optional[Instrumentation]: The installed instrumentation, if any.
+    """
+    return _instrumentation
+
+
+def _span(name, **attributes):
+    """Returns a context manager reporting an operation to the installed
+    instrumentation, or a shared no-op one when there is none."""
+    instrumentation = _instrumentation
+    if instrumentation is None:
+        return _NO_OP_SPAN
+    return instrumentation.start_span(name, attributes)
+
+
+def _refresh_span(credentials):
+    """Returns a context manager reporting a refresh of the credentials as a
+    ``google.auth.credentials.refresh`` operation."""
+    return _span(
+        "google.auth.credentials.refresh", credentials=type(credentials).__name__
+    )
+
+
+def _traced_refresh(credentials, request):
+    """Refreshes the credentials, reporting it as an operation.
+
+    Args:
+        credentials (google.auth.credentials.Credentials): The credentials
+            to refresh.
+        request (google.auth.transport.Request): The object used to make
+            HTTP requests.
+
+    Returns:
+        Any: The result of the refresh.
+    """
+    with _refresh_span(credentials):
+        return credentials.refresh(request)
+
+
+def _traced(name):
+    """Decorator reporting each call of the function as an operation."""
+
+    def decorator(func):
+        @functools.wraps(func)
+        def wrapper(*args, **kwargs):
+            if _instrumentation is None:
+                return func(*args, **kwargs)
+            with _span(name):
+                return func(*args, **kwargs)
+
+        return wrapper
+
+    return decorator
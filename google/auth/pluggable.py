@@ -28,6 +28,25 @@ Example credential_source for pluggable credential:
         "output_file": "/path/to/generated/cached/credentials"
     }
 }
+
+Executables that are costly to start can instead be kept running by setting
+``"daemon": true``. The executable is then started once, reads requests from
+its standard input and writes its responses to its standard output, both as
+JSON objects on a single line. A request looks like::
+
+    {
+        "version": 1,
+        "audience": "//iam.googleapis.com/...",
+        "subject_token_type": "urn:ietf:params:oauth:token-type:jwt",
+        "interactive": false,
+        "impersonated_email": "sa@project.iam.gserviceaccount.com",
+        "output_file": "/path/to/generated/cached/credentials"
+    }
+
+where ``impersonated_email`` and ``output_file`` are only set when configured.
+The response is the same as the output of an executable run once. The
+executable is started again if it exits, and killed if it doesn't respond
+within ``timeout_millis``.
 """
 
 try:
@@ -37,14 +56,19 @@ except ImportError:  # pragma: NO COVER
     from collections import Mapping
 import io
 import json
+import logging
 import os
 import subprocess
 import time
 
+from google.auth import _executable_daemon
+from google.auth import _file_lock
 from google.auth import _helpers
 from google.auth import exceptions
 from google.auth import external_account
 
+_LOGGER = logging.getLogger(__name__)
+
 # The max supported executable spec version.
 EXECUTABLE_SUPPORTED_MAX_VERSION = 1
 
@@ -86,6 +110,9 @@ class Credentials(external_account.Credentials):
                         }
                     }
 
+                Set ``"daemon": true`` in ``executable`` to keep the
+                executable running between refreshes.
+
             service_account_impersonation_url (Optional[str]): The optional service account
                 impersonation getAccessToken URL.
             client_id (Optional[str]): The optional client ID.
@@ -143,6 +170,9 @@ class Credentials(external_account.Credentials):
         self._credential_source_executable_output_file = self._credential_source_executable.get(
             "output_file"
         )
+        self._credential_source_executable_daemon = bool(
+            self._credential_source_executable.get("daemon")
+        )
 
         if not self._credential_source_executable_command:
             raise ValueError(
@@ -166,46 +196,75 @@ class Credentials(external_account.Credentials):
                 "Executables need to be explicitly allowed (set GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES to '1') to run."
             )
 
-        # Check output file.
-        if self._credential_source_executable_output_file is not None:
-            try:
-                with open(
-                    self._credential_source_executable_output_file
-                ) as output_file:
-                    response = json.load(output_file)
-            except Exception:
-                pass
-            else:
-                try:
-                    # If the cached response is expired, _parse_subject_token will raise an error which will be ignored and we will call the executable again.
-                    subject_token = self._parse_subject_token(response)
-                except ValueError:
-                    raise
-                except exceptions.RefreshError:
-                    pass
-                else:
-                    return subject_token
+        subject_token = self._read_output_file()
+        if subject_token is not None:
+            return subject_token
 
         if not _helpers.is_python_3():
             raise exceptions.RefreshError(
                 "Pluggable auth is only supported for python 3.6+"
             )
 
-        # Inject env vars.
-        env = os.environ.copy()
-        env["GOOGLE_EXTERNAL_ACCOUNT_AUDIENCE"] = self._audience
-        env["GOOGLE_EXTERNAL_ACCOUNT_TOKEN_TYPE"] = self._subject_token_type
-        env[
-            "GOOGLE_EXTERNAL_ACCOUNT_INTERACTIVE"
-        ] = "0"  # Always set to 0 until interactive mode is implemented.
-        if self._service_account_impersonation_url is not None:
-            env[
-                "GOOGLE_EXTERNAL_ACCOUNT_IMPERSONATED_EMAIL"
-            ] = self.service_account_email
-        if self._credential_source_executable_output_file is not None:
-            env[
-                "GOOGLE_EXTERNAL_ACCOUNT_OUTPUT_FILE"
-            ] = self._credential_source_executable_output_file
+        if self._credential_source_executable_output_file is None:
+            return self._run_executable()
+
+        # Only one process of the host runs the executable when the cached
+        # response expires. The others wait for it, then read its response
+        # from the output file.
+        lock = _file_lock.FileLock(
+            self._credential_source_executable_output_file + ".lock"
+        )
+        try:
+            acquired = lock.acquire(
+                2 * self._credential_source_executable_timeout_millis / 1000
+            )
+        except (IOError, OSError) as caught_exc:
+            _LOGGER.debug("Running the executable without a lock: %s", caught_exc)
+            return self._run_executable()
+        if not acquired:
+            raise exceptions.RefreshError(
+                "Timed out waiting for another process to run the executable."
+            )
+        try:
+            subject_token = self._read_output_file()
+            if subject_token is not None:
+                return subject_token
+            return self._run_executable()
+        finally:
+            lock.release()
+
+    def _read_output_file(self):
+        """Returns the subject token cached in the output file, or None if
+        it is missing or expired."""
+        if self._credential_source_executable_output_file is None:
+            return None
+        try:
+            with open(self._credential_source_executable_output_file) as output_file:
+                response = json.load(output_file)
+        except Exception:
+            return None
+        try:
+            # If the cached response is expired, _parse_subject_token will raise an error which will be ignored and we will call the executable again.
+            return self._parse_subject_token(response)
+        except exceptions.RefreshError:
+            return None
+
+    def _write_output_file(self, response):
+        """Caches a successful response in the output file, replacing it
+        atomically so that other processes never read a partial response."""
+        if self._credential_source_executable_output_file is None:
+            return
+        try:
+            _file_lock.write_atomically(
+                self._credential_source_executable_output_file, json.dumps(response)
+            )
+        except (IOError, OSError) as caught_exc:
+            _LOGGER.debug("Unable to write the output file: %s", caught_exc)
+
+    def _run_executable(self):
+        env = self._executable_environment()
+        if self._credential_source_executable_daemon:
+            return self._request_daemon(env)
 
         try:
             result = subprocess.run(
@@ -231,6 +290,47 @@ class Credentials(external_account.Credentials):
             except Exception:
                 raise
 
+        self._write_output_file(response)
+        return subject_token
+
+    def _executable_environment(self):
+        # Inject env vars.
+        env = os.environ.copy()
+        env["GOOGLE_EXTERNAL_ACCOUNT_AUDIENCE"] = self._audience
+        env["GOOGLE_EXTERNAL_ACCOUNT_TOKEN_TYPE"] = self._subject_token_type
+        env[
+            "GOOGLE_EXTERNAL_ACCOUNT_INTERACTIVE"
+        ] = "0"  # Always set to 0 until interactive mode is implemented.
+        if self._service_account_impersonation_url is not None:
+            env[
+                "GOOGLE_EXTERNAL_ACCOUNT_IMPERSONATED_EMAIL"
+            ] = self.service_account_email
+        if self._credential_source_executable_output_file is not None:
+            env[
+                "GOOGLE_EXTERNAL_ACCOUNT_OUTPUT_FILE"
+            ] = self._credential_source_executable_output_file
+        return env
+
+    def _request_daemon(self, env):
+        env["GOOGLE_EXTERNAL_ACCOUNT_DAEMON"] = "1"
+        daemon = _executable_daemon.get_daemon(
+            self._credential_source_executable_command.split(), env
+        )
+        message = {
+            "version": EXECUTABLE_SUPPORTED_MAX_VERSION,
+            "audience": self._audience,
+            "subject_token_type": self._subject_token_type,
+            "interactive": False,
+        }
+        if self._service_account_impersonation_url is not None:
+            message["impersonated_email"] = self.service_account_email
+        if self._credential_source_executable_output_file is not None:
+            message["output_file"] = self._credential_source_executable_output_file
+        response = daemon.request(
+            message, self._credential_source_executable_timeout_millis / 1000
+        )
+        subject_token = self._parse_subject_token(response)
+        self._write_output_file(response)
         return subject_token
 
     @classmethod
@@ -21,13 +21,18 @@ change in minor releases.
 from __future__ import absolute_import
 
 import asyncio
+import datetime
 import functools
+import inspect
+import weakref
 
 import aiohttp  # type: ignore
 import six
 import urllib3  # type: ignore
 
+from google.auth import _helpers
 from google.auth import exceptions
+from google.auth import instrumentation
 from google.auth import transport
 from google.auth.transport import requests
 
@@ -35,6 +40,11 @@ from google.auth.transport import requests
 # sync timeout.
 _DEFAULT_TIMEOUT = 180  # in seconds
 
+# How long before the token expires a background refresh is started. This is
+# well ahead of google.auth._helpers.REFRESH_THRESHOLD so that the new token is
+# usually in place before any request has to wait for it.
+_DEFAULT_REFRESH_AHEAD = datetime.timedelta(minutes=3, seconds=45)
+
 
 class _CombinedResponse(transport.Response):
     """
@@ -198,6 +208,148 @@ class Request(transport.Request):
             six.raise_from(new_exc, caught_exc)
 
 
+class _RefreshManager(object):
+    """Coordinates credential refreshes for an :class:`AuthorizedSession`.
+
+    At most one refresh per event loop is in flight at any time; concurrent
+    callers await the refresh already running instead of starting their own.
+    When the token is still valid but will expire within ``refresh_ahead``, a
+    refresh is started in the background and callers carry on with the
+    current token.
+
+    A refresh is shared by all the callers waiting on it and may outlive the
+    caller that started it, so it never uses a caller's request. It uses
+    ``auth_request``, or else a client session owned by the manager until
+    :meth:`close`.
+
+    No event loop is bound at construction, so the manager can be created
+    outside of a running loop and used from several loops.
+
+    Args:
+        credentials (google.auth._credentials_async.Credentials): The
+            credentials to refresh.
+        refresh_ahead (datetime.timedelta): How long before the credentials'
+            ``expiry`` a background refresh is started.
+        refresh_timeout (Optional[int]): The timeout value in seconds for
+            refresh HTTP requests.
+        auth_request (Optional[google.auth.transport.aiohttp_requests.Request]):
+            The request used for refreshes. If not passed, the manager
+            creates a client session for each event loop it is used from.
+    """
+
+    def __init__(
+        self,
+        credentials,
+        refresh_ahead=_DEFAULT_REFRESH_AHEAD,
+        refresh_timeout=None,
+        auth_request=None,
+    ):
+        self._credentials = credentials
+        self._refresh_ahead = refresh_ahead
+        self._refresh_timeout = refresh_timeout
+        self._auth_request = auth_request
+        # Maps an event loop to the refresh task currently running on it.
+        self._tasks = weakref.WeakKeyDictionary()
+        # Maps an event loop to the request owned by the manager on it.
+        self._requests = weakref.WeakKeyDictionary()
+
+    def _refresh_ahead_due(self):
+        expiry = self._credentials.expiry
+        if not isinstance(expiry, datetime.datetime):
+            return False
+        return _helpers.utcnow() >= expiry - self._refresh_ahead
+
+    def get_request(self):
+        """Returns the request used for refreshes on the current event loop.
+
+        Returns:
+            google.auth.transport.Request: ``auth_request``, or the request
+                owned by the manager.
+        """
+        if self._auth_request is not None:
+            return self._auth_request
+        loop = asyncio.get_event_loop()
+        request = self._requests.get(loop)
+        if request is None:
+            request = Request(aiohttp.ClientSession(auto_decompress=False))
+            self._requests[loop] = request
+        return request
+
+    async def _do_refresh(self):
+        request = self.get_request()
+        if self._refresh_timeout is not None:
+            request = functools.partial(request, timeout=self._refresh_timeout)
+        refresh = self._credentials.refresh
+        with instrumentation._refresh_span(self._credentials):
+            if inspect.iscoroutinefunction(refresh):
+                await refresh(request)
+            else:
+                loop = asyncio.get_event_loop()
+                await loop.run_in_executor(None, refresh, request)
+
+    def _start(self):
+        loop = asyncio.get_event_loop()
+        task = self._tasks.get(loop)
+        if task is None or task.done():
+            task = loop.create_task(self._do_refresh())
+            task.add_done_callback(_log_refresh_failure)
+            self._tasks[loop] = task
+        return task
+
+    async def refresh(self, stale_token=None):
+        """Refreshes the credentials, joining a refresh already in flight.
+
+        Args:
+            stale_token (Optional[str]): The token that was rejected. If the
+                credentials already hold a different token, another caller has
+                refreshed them and no refresh is made.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If the credentials could
+                not be refreshed.
+        """
+        if stale_token is not None and self._credentials.token != stale_token:
+            return
+        # Shield the shared task so that a cancelled caller does not cancel
+        # the refresh for everyone else waiting on it.
+        await asyncio.shield(self._start())
+
+    async def before_request(self):
+        """Makes sure the credentials can be used for a request.
+
+        Invalid credentials are refreshed and the call waits for the refresh.
+        Credentials that are about to expire are refreshed in the background
+        without waiting.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If the credentials could
+                not be refreshed.
+        """
+        if not self._credentials.valid:
+            await self.refresh()
+        elif self._refresh_ahead_due():
+            self._start()
+
+    async def close(self):
+        """Cancels the refresh running on the current event loop, if any, and
+        closes the client session the manager owns on it."""
+        loop = asyncio.get_event_loop()
+        task = self._tasks.pop(loop, None)
+        if task is not None:
+            task.cancel()
+        request = self._requests.pop(loop, None)
+        if request is not None:
+            await request.session.close()
+
+
+def _log_refresh_failure(task):
+    if task.cancelled():
+        return
+    exc = task.exception()
+    if exc is not None:
+        requests._LOGGER.debug("Credential refresh failed: %s", exc)
+
+
 class AuthorizedSession(aiohttp.ClientSession):
     """This is an async implementation of the Authorized Session class. We utilize an
     aiohttp transport instance, and the interface mirrors the google.auth.transport.requests
@@ -216,6 +368,9 @@ class AuthorizedSession(aiohttp.ClientSession):
 
     The underlying :meth:`request` implementation handles adding the
     credentials' headers to the request and refreshing credentials as needed.
+    Concurrent requests share a single in-flight refresh, and credentials that
+    are close to expiry are refreshed in the background so that requests do not
+    wait for the refresh.
 
     Args:
         credentials (google.auth._credentials_async.Credentials):
@@ -251,11 +406,16 @@ class AuthorizedSession(aiohttp.ClientSession):
         self._refresh_timeout = refresh_timeout
         self._is_mtls = False
         self._auth_request = auth_request
-        self._auth_request_session = None
-        self._loop = asyncio.get_event_loop()
-        self._refresh_lock = asyncio.Lock()
+        self._refresh_manager = _RefreshManager(
+            credentials, refresh_timeout=refresh_timeout, auth_request=auth_request
+        )
         self._auto_decompress = auto_decompress
 
+    async def close(self):
+        """Cancels any pending credential refresh and closes the session."""
+        await self._refresh_manager.close()
+        await super(AuthorizedSession, self).close()
+
     async def request(
         self,
         method,
@@ -304,85 +464,62 @@ class AuthorizedSession(aiohttp.ClientSession):
                 if type(headers[key]) is bytes:
                     headers[key] = headers[key].decode("utf-8")
 
-        async with aiohttp.ClientSession(
-            auto_decompress=self._auto_decompress
-        ) as self._auth_request_session:
-            auth_request = Request(self._auth_request_session)
-            self._auth_request = auth_request
-
-            # Use a kwarg for this instead of an attribute to maintain
-            # thread-safety.
-            _credential_refresh_attempt = kwargs.pop("_credential_refresh_attempt", 0)
-            # Make a copy of the headers. They will be modified by the credentials
-            # and we want to pass the original headers if we recurse.
-            request_headers = headers.copy() if headers is not None else {}
-
-            # Do not apply the timeout unconditionally in order to not override the
-            # _auth_request's default timeout.
-            auth_request = (
-                self._auth_request
-                if timeout is None
-                else functools.partial(self._auth_request, timeout=timeout)
+        # Use a kwarg for this instead of an attribute to maintain
+        # thread-safety.
+        _credential_refresh_attempt = kwargs.pop("_credential_refresh_attempt", 0)
+        # Make a copy of the headers. They will be modified by the credentials
+        # and we want to pass the original headers if we recurse.
+        request_headers = headers.copy() if headers is not None else {}
+
+        remaining_time = max_allowed_time
+
+        # Refreshes share the request of the refresh manager, which outlives
+        # this call, since a refresh may be joined by concurrent requests.
+        with requests.TimeoutGuard(remaining_time, asyncio.TimeoutError) as guard:
+            await self._refresh_manager.before_request()
+            await self.credentials.before_request(
+                self._refresh_manager.get_request(), method, url, request_headers
+            )
+        token = self.credentials.token
+
+        with requests.TimeoutGuard(remaining_time, asyncio.TimeoutError) as guard:
+            response = await super(AuthorizedSession, self).request(
+                method,
+                url,
+                data=data,
+                headers=request_headers,
+                timeout=timeout,
+                **kwargs,
             )
 
-            remaining_time = max_allowed_time
+        remaining_time = guard.remaining_timeout
 
-            with requests.TimeoutGuard(remaining_time, asyncio.TimeoutError) as guard:
-                await self.credentials.before_request(
-                    auth_request, method, url, request_headers
-                )
+        if (
+            response.status in self._refresh_status_codes
+            and _credential_refresh_attempt < self._max_refresh_attempts
+        ):
+
+            requests._LOGGER.info(
+                "Refreshing credentials due to a %s response. Attempt %s/%s.",
+                response.status,
+                _credential_refresh_attempt + 1,
+                self._max_refresh_attempts,
+            )
 
             with requests.TimeoutGuard(remaining_time, asyncio.TimeoutError) as guard:
-                response = await super(AuthorizedSession, self).request(
-                    method,
-                    url,
-                    data=data,
-                    headers=request_headers,
-                    timeout=timeout,
-                    **kwargs,
-                )
+                await self._refresh_manager.refresh(stale_token=token)
 
             remaining_time = guard.remaining_timeout
 
-            if (
-                response.status in self._refresh_status_codes
-                and _credential_refresh_attempt < self._max_refresh_attempts
-            ):
-
-                requests._LOGGER.info(
-                    "Refreshing credentials due to a %s response. Attempt %s/%s.",
-                    response.status,
-                    _credential_refresh_attempt + 1,
-                    self._max_refresh_attempts,
-                )
-
-                # Do not apply the timeout unconditionally in order to not override the
-                # _auth_request's default timeout.
-                auth_request = (
-                    self._auth_request
-                    if timeout is None
-                    else functools.partial(self._auth_request, timeout=timeout)
-                )
-
-                with requests.TimeoutGuard(
-                    remaining_time, asyncio.TimeoutError
-                ) as guard:
-                    async with self._refresh_lock:
-                        await self._loop.run_in_executor(
-                            None, self.credentials.refresh, auth_request
-                        )
-
-                remaining_time = guard.remaining_timeout
-
-                return await self.request(
-                    method,
-                    url,
-                    data=data,
-                    headers=headers,
-                    max_allowed_time=remaining_time,
-                    timeout=timeout,
-                    _credential_refresh_attempt=_credential_refresh_attempt + 1,
-                    **kwargs,
-                )
+            return await self.request(
+                method,
+                url,
+                data=data,
+                headers=headers,
+                max_allowed_time=remaining_time,
+                timeout=timeout,
+                _credential_refresh_attempt=_credential_refresh_attempt + 1,
+                **kwargs,
+            )
 
         return response
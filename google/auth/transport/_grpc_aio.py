@@ -0,0 +1,313 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Authorization support for gRPC AsyncIO (``grpc.aio``).
+
+The authorization metadata is added by client interceptors running on the
+channel's event loop, so refreshing
+:class:`~google.auth._credentials_async.Credentials` is awaited on that loop
+instead of blocking it from a gRPC metadata plugin thread.
+
+NOTE: This async support is experimental and marked internal. This surface may
+change in minor releases.
+"""
+
+import inspect
+
+import six
+
+from google.auth import _helpers
+from google.auth.transport import _aiohttp_requests
+from google.auth.transport import grpc as google_auth_grpc
+from google.oauth2 import service_account
+
+try:
+    from grpc import aio  # type: ignore
+except ImportError as caught_exc:  # pragma: NO COVER
+    six.raise_from(
+        ImportError(
+            "gRPC AsyncIO is not available, please install grpcio>=1.32.0 "
+            "to use the gRPC AsyncIO transport."
+        ),
+        caught_exc,
+    )
+
+
+class AuthMetadataPlugin(object):
+    """Computes the authorization metadata for ``grpc.aio`` calls.
+
+    Valid credentials are applied without leaving the event loop. Invalid
+    credentials are refreshed once for all concurrent calls, and credentials
+    about to expire are refreshed in the background.
+
+    Args:
+        credentials (google.auth._credentials_async.Credentials): The
+            credentials to add to requests.
+        request (google.auth.transport._aiohttp_requests.Request): The async
+            HTTP transport request object used to refresh credentials as
+            needed.
+        default_host (Optional[str]): A host like "pubsub.googleapis.com".
+            This is used when a self-signed JWT is created from service
+            account credentials.
+    """
+
+    def __init__(self, credentials, request, default_host=None):
+        self._credentials = credentials
+        self._request = request
+        self._default_host = default_host
+        self._refresh_manager = _aiohttp_requests._RefreshManager(
+            credentials, auth_request=request
+        )
+
+    def _get_self_signed_jwt_credentials(self):
+        """Returns the self-signed JWT credentials for the audience of the
+        plugin, or None if service account credentials don't use one.
+
+        The JWT credentials are kept by the service account credentials for
+        each audience, so that plugins for different hosts sharing the
+        credentials each send their own audience.
+        """
+        # https://google.aip.dev/auth/4111
+        # Attempt to use self-signed JWTs when a service account is used.
+        # Domain-wide delegation doesn't work with self-signed JWTs.
+        if (
+            isinstance(self._credentials, service_account.Credentials)
+            and self._credentials._subject is None
+        ):
+            return self._credentials._get_self_signed_jwt_credentials(
+                "https://{}/".format(self._default_host) if self._default_host else None
+            )
+        return None
+
+    async def __call__(self, method_name, service_url):
+        """Gets the authorization metadata for a call.
+
+        Args:
+            method_name (str): The name of the RPC method being invoked.
+            service_url (str): The RPC service's URI.
+
+        Returns:
+            Sequence[Tuple[str, str]]: A list of metadata (key, value) pairs
+                to add to the call.
+        """
+        headers = {}
+        jwt_credentials = self._get_self_signed_jwt_credentials()
+        if jwt_credentials is not None:
+            # The self-signed JWT is signed locally, so applying it doesn't
+            # block the event loop on a request.
+            jwt_credentials.before_request(
+                self._request, method_name, service_url, headers
+            )
+            return list(six.iteritems(headers))
+
+        await self._refresh_manager.before_request()
+        # Async credentials return a coroutine; sync ones apply the (now
+        # valid) token directly.
+        result = self._credentials.before_request(
+            self._request, method_name, service_url, headers
+        )
+        if inspect.isawaitable(result):
+            await result
+        return list(six.iteritems(headers))
+
+
+class _AuthMetadataInterceptor(object):
+    """Base for the interceptors adding authorization metadata to calls.
+
+    Args:
+        plugin (AuthMetadataPlugin): The plugin computing the metadata.
+        host (str): The host of the channel's target, used to build the
+            service URL passed to the credentials.
+    """
+
+    def __init__(self, plugin, host):
+        self._plugin = plugin
+        self._host = host
+
+    async def _authorize(self, client_call_details):
+        # The method is "/package.Service/Method".
+        service, _, method_name = _helpers.from_bytes(
+            client_call_details.method
+        ).rpartition("/")
+        service_url = "https://{}{}".format(self._host, service)
+        metadata = list(client_call_details.metadata or ())
+        metadata.extend(await self._plugin(method_name, service_url))
+        return client_call_details._replace(metadata=tuple(metadata))
+
+
+class _UnaryUnaryInterceptor(
+    _AuthMetadataInterceptor, aio.UnaryUnaryClientInterceptor
+):
+    async def intercept_unary_unary(self, continuation, client_call_details, request):
+        details = await self._authorize(client_call_details)
+        return await continuation(details, request)
+
+
+class _UnaryStreamInterceptor(
+    _AuthMetadataInterceptor, aio.UnaryStreamClientInterceptor
+):
+    async def intercept_unary_stream(self, continuation, client_call_details, request):
+        details = await self._authorize(client_call_details)
+        return await continuation(details, request)
+
+
+class _StreamUnaryInterceptor(
+    _AuthMetadataInterceptor, aio.StreamUnaryClientInterceptor
+):
+    async def intercept_stream_unary(
+        self, continuation, client_call_details, request_iterator
+    ):
+        details = await self._authorize(client_call_details)
+        return await continuation(details, request_iterator)
+
+
+class _StreamStreamInterceptor(
+    _AuthMetadataInterceptor, aio.StreamStreamClientInterceptor
+):
+    async def intercept_stream_stream(
+        self, continuation, client_call_details, request_iterator
+    ):
+        details = await self._authorize(client_call_details)
+        return await continuation(details, request_iterator)
+
+
+def _target_host(target):
+    """Extracts the host of a gRPC channel target.
+
+    Handles plain ``host:port`` targets, IPv6 addresses in brackets and the
+    ``dns``, ``ipv4``, ``ipv6`` and ``unix`` name resolver schemes.
+
+    Args:
+        target (str): The channel target, such as ``pubsub.googleapis.com:443``
+            or ``dns:///[::1]:8080``.
+
+    Returns:
+        str: The host, with IPv6 addresses in brackets.
+    """
+    scheme, sep, address = target.partition(":")
+    if not sep or scheme not in ("dns", "ipv4", "ipv6", "unix", "unix-abstract"):
+        address = target
+    elif scheme.startswith("unix"):
+        return "localhost"
+    elif scheme == "dns":
+        # dns:[//authority/]host[:port]
+        if address.startswith("//"):
+            address = address[2:].partition("/")[2]
+    else:
+        # ipv4:address[:port][,address[:port],...]
+        address = address.split(",")[0]
+
+    if address.startswith("["):
+        return address[: address.index("]") + 1]
+    if address.count(":") == 1:
+        return address.split(":")[0]
+    if address.count(":") > 1:
+        # An IPv6 address without a port.
+        return "[{}]".format(address)
+    return address
+
+
+def auth_interceptors(plugin, target):
+    """Creates the ``grpc.aio`` client interceptors for a metadata plugin.
+
+    ``grpc.aio`` channels dispatch each interceptor by its call type, so one
+    interceptor is needed per type.
+
+    Args:
+        plugin (AuthMetadataPlugin): The plugin computing the metadata.
+        target (str): The host and port of the service.
+
+    Returns:
+        Sequence[grpc.aio.ClientInterceptor]: The interceptors.
+    """
+    host = _target_host(target)
+    return [
+        interceptor_class(plugin, host)
+        for interceptor_class in (
+            _UnaryUnaryInterceptor,
+            _UnaryStreamInterceptor,
+            _StreamUnaryInterceptor,
+            _StreamStreamInterceptor,
+        )
+    ]
+
+
+def secure_authorized_aio_channel(
+    credentials,
+    request,
+    target,
+    ssl_credentials=None,
+    client_cert_callback=None,
+    default_host=None,
+    **kwargs
+):
+    """Creates a secure authorized ``grpc.aio`` channel.
+
+    This is the AsyncIO counterpart of
+    :func:`google.auth.transport.grpc.secure_authorized_channel`; the SSL
+    credentials are chosen the same way::
+
+        import google.auth._default_async
+        from google.auth.transport import _aiohttp_requests
+        from google.auth.transport import _grpc_aio
+
+        credentials, _ = google.auth._default_async.default_async()
+        request = _aiohttp_requests.Request()
+
+        channel = _grpc_aio.secure_authorized_aio_channel(
+            credentials, request, 'pubsub.googleapis.com:443')
+
+    Args:
+        credentials (google.auth._credentials_async.Credentials): The
+            credentials to add to requests.
+        request (google.auth.transport._aiohttp_requests.Request): The async
+            HTTP transport request object used to refresh credentials as
+            needed.
+        target (str): The host and port of the service.
+        ssl_credentials (grpc.ChannelCredentials): Optional SSL channel
+            credentials. This argument is mutually exclusive with
+            client_cert_callback; providing both will raise an exception.
+        client_cert_callback (Callable[[], (bytes, bytes)]): Optional
+            callback function to obtain client certicate and key for mutual TLS
+            connection. This argument does nothing unless
+            `GOOGLE_API_USE_CLIENT_CERTIFICATE` environment variable is
+            explicitly set to `true`.
+        default_host (Optional[str]): A host like "pubsub.googleapis.com".
+            This is used when a self-signed JWT is created from service
+            account credentials.
+        kwargs: Additional arguments to pass to :func:`grpc.aio.secure_channel`.
+            Interceptors passed in ``interceptors`` run before the ones adding
+            the authorization metadata.
+
+    Returns:
+        grpc.aio.Channel: The created gRPC AsyncIO channel.
+
+    Raises:
+        google.auth.exceptions.MutualTLSChannelError: If mutual TLS channel
+            creation failed for any reason.
+    """
+    metadata_plugin = AuthMetadataPlugin(
+        credentials, request, default_host=default_host
+    )
+
+    ssl_credentials = google_auth_grpc._get_ssl_credentials(
+        ssl_credentials, client_cert_callback
+    )
+
+    interceptors = list(kwargs.pop("interceptors", None) or ())
+    interceptors.extend(auth_interceptors(metadata_plugin, target))
+
+    return aio.secure_channel(
+        target, ssl_credentials, interceptors=interceptors, **kwargs
+    )
@@ -16,13 +16,16 @@
 
 from __future__ import absolute_import
 
+from concurrent import futures
 import logging
 import os
+import threading
 
 import six
 
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import instrumentation
 from google.auth.transport import _mtls_helper
 from google.oauth2 import service_account
 
@@ -39,11 +42,36 @@ except ImportError as caught_exc:  # pragma: NO COVER
 
 _LOGGER = logging.getLogger(__name__)
 
+# The maximum number of credential refreshes run at once for all the plugins.
+_MAX_REFRESH_WORKERS = 4
+
+# The executor running the refreshes of all the plugins, created on the first
+# refresh so that channels don't each own a thread.
+_refresh_executor = None
+_refresh_executor_lock = threading.Lock()
+
+
+def _get_refresh_executor():
+    """Returns the executor shared by all the plugins for their refreshes."""
+    global _refresh_executor
+    with _refresh_executor_lock:
+        if _refresh_executor is None:
+            _refresh_executor = futures.ThreadPoolExecutor(
+                max_workers=_MAX_REFRESH_WORKERS
+            )
+        return _refresh_executor
+
 
 class AuthMetadataPlugin(grpc.AuthMetadataPlugin):
     """A `gRPC AuthMetadataPlugin`_ that inserts the credentials into each
     request.
 
+    While the credentials are valid the metadata is passed to gRPC right away.
+    Otherwise the credentials are refreshed on a thread shared by the plugins,
+    so gRPC's callback thread is never blocked by the refresh, and the
+    metadata is passed to gRPC once the refresh is done. RPCs that start
+    while a refresh is in progress wait for that same refresh.
+
     .. _gRPC AuthMetadataPlugin:
         http://www.grpc.io/grpc/python/grpc.html#grpc.AuthMetadataPlugin
 
@@ -65,26 +93,45 @@ class AuthMetadataPlugin(grpc.AuthMetadataPlugin):
         self._credentials = credentials
         self._request = request
         self._default_host = default_host
+        self._refresh_lock = threading.Lock()
+        self._refresh_future = None
 
-    def _get_authorization_headers(self, context):
-        """Gets the authorization headers for a request.
+    def _get_credentials(self):
+        """Returns the credentials whose token is sent with the requests.
+
+        Service account credentials send a self-signed JWT for the audience
+        of the plugin when one applies. The JWT credentials are kept by the
+        service account credentials for each audience, so that plugins for
+        different hosts sharing the credentials each send their own audience.
 
         Returns:
-            Sequence[Tuple[str, str]]: A list of request headers (key, value)
-                to add to the request.
+            google.auth.credentials.Credentials: The credentials to apply.
         """
-        headers = {}
-
         # https://google.aip.dev/auth/4111
         # Attempt to use self-signed JWTs when a service account is used.
         # A default host must be explicitly provided since it cannot always
-        # be determined from the context.service_url.
-        if isinstance(self._credentials, service_account.Credentials):
-            self._credentials._create_self_signed_jwt(
+        # be determined from the context.service_url. Domain-wide delegation
+        # doesn't work with self-signed JWTs.
+        if (
+            isinstance(self._credentials, service_account.Credentials)
+            and self._credentials._subject is None
+        ):
+            jwt_credentials = self._credentials._get_self_signed_jwt_credentials(
                 "https://{}/".format(self._default_host) if self._default_host else None
             )
+            if jwt_credentials is not None:
+                return jwt_credentials
+        return self._credentials
+
+    def _get_authorization_headers(self, context):
+        """Gets the authorization headers for a request.
 
-        self._credentials.before_request(
+        Returns:
+            Sequence[Tuple[str, str]]: A list of request headers (key, value)
+                to add to the request.
+        """
+        headers = {}
+        self._get_credentials().before_request(
             self._request, context.method_name, context.service_url, headers
         )
 
@@ -98,7 +145,43 @@ class AuthMetadataPlugin(grpc.AuthMetadataPlugin):
             callback (grpc.AuthMetadataPluginCallback): The callback that will
                 be invoked to pass in the authorization metadata.
         """
-        callback(self._get_authorization_headers(context), None)
+        credentials = self._get_credentials()
+        if credentials.valid:
+            callback(self._get_authorization_headers(context), None)
+            return
+
+        future = self._start_refresh(credentials)
+        future.add_done_callback(
+            lambda refresh: self._on_refresh_done(refresh, credentials, callback)
+        )
+
+    def _start_refresh(self, credentials):
+        """Starts a credentials refresh, or returns the one in progress.
+
+        Args:
+            credentials (google.auth.credentials.Credentials): The credentials
+                to refresh.
+
+        Returns:
+            concurrent.futures.Future: The future of the refresh.
+        """
+        with self._refresh_lock:
+            if self._refresh_future is None or self._refresh_future.done():
+                self._refresh_future = _get_refresh_executor().submit(
+                    instrumentation._traced_refresh, credentials, self._request
+                )
+            return self._refresh_future
+
+    def _on_refresh_done(self, refresh, credentials, callback):
+        exc = refresh.exception()
+        if exc is not None:
+            _LOGGER.debug("Failed to refresh credentials: %s", exc)
+            callback((), exc)
+            return
+
+        headers = {}
+        credentials.apply(headers)
+        callback(list(six.iteritems(headers)), None)
 
 
 def secure_authorized_channel(
@@ -254,6 +337,29 @@ def secure_authorized_channel(
     # Create a set of grpc.CallCredentials using the metadata plugin.
     google_auth_credentials = grpc.metadata_call_credentials(metadata_plugin)
 
+    ssl_credentials = _get_ssl_credentials(ssl_credentials, client_cert_callback)
+
+    # Combine the ssl credentials and the authorization credentials.
+    composite_credentials = grpc.composite_channel_credentials(
+        ssl_credentials, google_auth_credentials
+    )
+
+    return grpc.secure_channel(target, composite_credentials, **kwargs)
+
+
+def _get_ssl_credentials(ssl_credentials, client_cert_callback):
+    """Chooses the SSL channel credentials for an authorized channel.
+
+    See :func:`secure_authorized_channel` for how the arguments are used.
+
+    Returns:
+        grpc.ChannelCredentials: The SSL channel credentials to use.
+
+    Raises:
+        ValueError: If both ssl_credentials and client_cert_callback are set.
+        google.auth.exceptions.MutualTLSChannelError: If mutual TLS channel
+            creation failed for any reason.
+    """
     if ssl_credentials and client_cert_callback:
         raise ValueError(
             "Received both ssl_credentials and client_cert_callback; "
@@ -278,12 +384,7 @@ def secure_authorized_channel(
         else:
             ssl_credentials = grpc.ssl_channel_credentials()
 
-    # Combine the ssl credentials and the authorization credentials.
-    composite_credentials = grpc.composite_channel_credentials(
-        ssl_credentials, google_auth_credentials
-    )
-
-    return grpc.secure_channel(target, composite_credentials, **kwargs)
+    return ssl_credentials
 
 
 class SslCredentials:
@@ -43,6 +43,7 @@ import six  # pylint: disable=ungrouped-imports
 
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import instrumentation
 from google.auth import transport
 import google.auth.transport._mtls_helper
 from google.oauth2 import service_account
@@ -582,7 +583,12 @@ class AuthorizedSession(requests.Session):
             )
 
             with TimeoutGuard(remaining_time) as guard:
-                self.credentials.refresh(auth_request)
+                with instrumentation._span(
+                    "google.auth.transport.refresh_retry",
+                    status=str(response.status_code),
+                    attempt=str(_credential_refresh_attempt + 1),
+                ):
+                    self.credentials.refresh(auth_request)
             remaining_time = guard.remaining_timeout
 
             # Recurse. Pass in the original headers, not our modified set, but
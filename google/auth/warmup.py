@@ -0,0 +1,257 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Warms up credentials at process start.
+
+Credentials fetch their first token lazily, on the first request they
+authorize. A service that creates several credentials at boot would make its
+first requests wait for all of those refreshes, one after the other.
+:func:`warm_up` refreshes them concurrently ahead of time instead, and
+reports how long each took and which failed, so that a readiness probe can
+wait for the auth layer to be ready::
+
+    import google.auth
+    import google.auth.transport.requests
+    from google.auth import warmup
+
+    credentials, _ = google.auth.default()
+    request = google.auth.transport.requests.Request()
+
+    report = warmup.warm_up(
+        request,
+        credentials={"default": credentials},
+        audiences=["https://example.com/"],
+        deadline=10,
+    )
+    if not report.ok:
+        for result in report.failures:
+            print(result.name, result.error)
+
+ID tokens are warmed up by minting them with
+:func:`google.oauth2.id_token.fetch_id_token`, or an
+:class:`~google.oauth2.id_token.IDTokenProvider`, which cache them for later
+calls.
+"""
+
+import inspect
+import threading
+import time
+
+from google.auth import exceptions
+from google.auth import instrumentation
+
+
+class WarmUpResult(object):
+    """The outcome of warming up one credential or ID token audience.
+
+    Attributes:
+        name (str): The name of the credentials, or the audience.
+        duration (float): How long the refresh took, in seconds. For
+            refreshes that didn't finish, how long was waited for them.
+        error (Optional[Exception]): The error the refresh raised, if any.
+            Refreshes that didn't finish before the deadline have a
+            :class:`google.auth.exceptions.RefreshError`.
+        done (bool): Whether the refresh finished before the deadline.
+    """
+
+    def __init__(self, name, duration, error, done):
+        self.name = name
+        self.duration = duration
+        self.error = error
+        self.done = done
+
+    @property
+    def ok(self):
+        """bool: Whether the refresh finished without an error."""
+        return self.done and self.error is None
+
+    def __repr__(self):
+        return "WarmUpResult(name={!r}, duration={:.3f}, error={!r})".format(
+            self.name, self.duration, self.error
+        )
+
+
+class WarmUpReport(object):
+    """The outcome of :func:`warm_up`.
+
+    Attributes:
+        results (Sequence[WarmUpResult]): The result of each credential,
+            followed by the result of each audience, in the order given.
+        duration (float): How long the whole warm-up took, in seconds.
+    """
+
+    def __init__(self, results, duration):
+        self.results = results
+        self.duration = duration
+
+    @property
+    def ok(self):
+        """bool: Whether every refresh finished without an error."""
+        return all(result.ok for result in self.results)
+
+    @property
+    def failures(self):
+        """Sequence[WarmUpResult]: The refreshes that failed or didn't
+        finish."""
+        return [result for result in self.results if not result.ok]
+
+    def __iter__(self):
+        return iter(self.results)
+
+
+class _WarmUpTask(object):
+    """Runs one refresh on a background daemon thread."""
+
+    def __init__(self, name, func):
+        self.name = name
+        self._func = func
+        self._done = threading.Event()
+        self._start = None
+        self._duration = None
+        self._error = None
+
+    def start(self):
+        self._start = time.time()
+        thread = threading.Thread(target=self._run, name="google-auth-warm-up")
+        thread.daemon = True
+        thread.start()
+
+    def _run(self):
+        try:
+            self._func()
+        except Exception as caught_exc:  # pylint: disable=broad-except
+            self._error = caught_exc
+        finally:
+            self._duration = time.time() - self._start
+            self._done.set()
+
+    def wait(self, timeout):
+        self._done.wait(timeout)
+
+    def result(self):
+        """Snapshots the outcome; a refresh finishing later doesn't change
+        it."""
+        if self._done.is_set():
+            return WarmUpResult(self.name, self._duration, self._error, True)
+        return WarmUpResult(
+            self.name,
+            time.time() - self._start,
+            exceptions.RefreshError(
+                "Warming up {} did not finish before the deadline.".format(
+                    self.name
+                )
+            ),
+            False,
+        )
+
+
+def _is_async(credentials):
+    # inspect.iscoroutinefunction is missing on Python 2, which has no async
+    # credentials.
+    iscoroutinefunction = getattr(inspect, "iscoroutinefunction", None)
+    return iscoroutinefunction is not None and iscoroutinefunction(
+        credentials.refresh
+    )
+
+
+def _refresh(credentials, request):
+    # Credentials that can't be refreshed, such as anonymous ones, are
+    # always valid.
+    if not credentials.valid:
+        result = instrumentation._traced_refresh(credentials, request)
+        isawaitable = getattr(inspect, "isawaitable", None)
+        if isawaitable is not None and isawaitable(result):
+            # Close the coroutine so that it isn't reported as never awaited.
+            getattr(result, "close", lambda: None)()
+            raise exceptions.RefreshError(
+                "Refreshing the credentials returned an awaitable; async "
+                "credentials can't be warmed up with warm_up."
+            )
+
+
+def warm_up(
+    request, credentials=(), audiences=(), id_token_provider=None, deadline=None
+):
+    """Refreshes credentials and mints ID tokens concurrently.
+
+    Each refresh runs on its own thread, so the warm-up takes about as long
+    as the slowest one. Credentials that are already valid aren't
+    refreshed.
+
+    Args:
+        request (google.auth.transport.Request): A callable used to make
+            HTTP requests. It is shared by all the refreshes, so it must be
+            safe to use from several threads, like
+            :class:`google.auth.transport.requests.Request`.
+        credentials (Union[Mapping[str, google.auth.credentials.Credentials], \
+            Sequence[google.auth.credentials.Credentials]]): The credentials
+            to refresh, by name. The results of a sequence of credentials are
+            named after their classes.
+        audiences (Sequence[str]): The audiences to mint ID tokens for.
+        id_token_provider (Optional[google.oauth2.id_token.IDTokenProvider]):
+            The provider to mint the ID tokens with. Defaults to the one used
+            by :func:`google.oauth2.id_token.fetch_id_token`.
+        deadline (Optional[float]): How long to wait for the refreshes, in
+            seconds. Refreshes still running at the deadline are reported as
+            failed, and left to finish in the background. Defaults to waiting
+            for all of them.
+
+    Returns:
+        WarmUpReport: The duration and error of each refresh.
+
+    Raises:
+        ValueError: If some of the credentials are async
+            (:class:`google.auth._credentials_async.Credentials`), whose
+            refresh must be awaited on an event loop.
+    """
+    from google.oauth2 import id_token
+
+    if hasattr(credentials, "items"):
+        credentials = list(credentials.items())
+    else:
+        credentials = [(type(creds).__name__, creds) for creds in credentials]
+
+    async_names = [name for name, creds in credentials if _is_async(creds)]
+    if async_names:
+        raise ValueError(
+            "Async credentials can't be warmed up with warm_up: {}.".format(
+                ", ".join(async_names)
+            )
+        )
+
+    if id_token_provider is None:
+        fetch_id_token = id_token.fetch_id_token
+    else:
+        fetch_id_token = id_token_provider.get_token
+
+    tasks = [
+        _WarmUpTask(name, lambda creds=creds: _refresh(creds, request))
+        for name, creds in credentials
+    ]
+    tasks.extend(
+        _WarmUpTask(audience, lambda aud=audience: fetch_id_token(request, aud))
+        for audience in audiences
+    )
+
+    start = time.time()
+    for task in tasks:
+        task.start()
+
+    for task in tasks:
+        if deadline is None:
+            task.wait(None)
+        else:
+            task.wait(max(0, start + deadline - time.time()))
+
+    return WarmUpReport([task.result() for task in tasks], time.time() - start)
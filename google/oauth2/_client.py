@@ -32,6 +32,7 @@ from six.moves import urllib
 
 from google.auth import _helpers
 from google.auth import exceptions
+from google.auth import instrumentation
 from google.auth import jwt
 
 _URLENCODED_CONTENT_TYPE = "application/x-www-form-urlencoded"
@@ -153,6 +154,7 @@ def _token_endpoint_request_no_throw(
     return True, response_data
 
 
+@instrumentation._traced("google.oauth2.token_endpoint_request")
 def _token_endpoint_request(
     request, token_uri, body, access_token=None, use_json=False, **kwargs
 ):
@@ -0,0 +1,142 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""OAuth 2.0 async Token Exchange client.
+
+NOTE: This file mirrors :mod:`google.oauth2.sts` with async/await syntax, for
+use with the :class:`google.auth.transport._aiohttp_requests.Request`
+transport. Concurrent exchanges made with :meth:`Client.exchange_tokens` run
+on the event loop and share the connection pool of the transport's session.
+"""
+
+import asyncio
+
+from google.auth import _helpers
+from google.auth import instrumentation
+from google.oauth2 import sts
+
+
+class Client(sts.Client):
+    """Implements the OAuth 2.0 token exchange spec based on
+    https://tools.ietf.org/html/rfc8693, with async/await syntax.
+    """
+
+    async def exchange_token(
+        self,
+        request,
+        grant_type,
+        subject_token,
+        subject_token_type,
+        resource=None,
+        audience=None,
+        scopes=None,
+        requested_token_type=None,
+        actor_token=None,
+        actor_token_type=None,
+        additional_options=None,
+        additional_headers=None,
+    ):
+        """Exchanges the provided token for another type of token based on the
+        rfc8693 spec.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+            grant_type (str): The OAuth 2.0 token exchange grant type.
+            subject_token (str): The OAuth 2.0 token exchange subject token.
+            subject_token_type (str): The OAuth 2.0 token exchange subject token type.
+            resource (Optional[str]): The optional OAuth 2.0 token exchange resource field.
+            audience (Optional[str]): The optional OAuth 2.0 token exchange audience field.
+            scopes (Optional[Sequence[str]]): The optional list of scopes to use.
+            requested_token_type (Optional[str]): The optional OAuth 2.0 token exchange requested
+                token type.
+            actor_token (Optional[str]): The optional OAuth 2.0 token exchange actor token.
+            actor_token_type (Optional[str]): The optional OAuth 2.0 token exchange actor token type.
+            additional_options (Optional[Mapping[str, str]]): The optional additional
+                non-standard Google specific options.
+            additional_headers (Optional[Mapping[str, str]]): The optional additional
+                headers to pass to the token exchange endpoint.
+
+        Returns:
+            Mapping[str, str]: The token exchange JSON-decoded response data containing
+                the requested token and its expiration time.
+
+        Raises:
+            google.auth.exceptions.OAuthError: If the token endpoint returned
+                an error.
+        """
+        headers, request_body = self._make_request(
+            grant_type,
+            subject_token,
+            subject_token_type,
+            resource=resource,
+            audience=audience,
+            scopes=scopes,
+            requested_token_type=requested_token_type,
+            actor_token=actor_token,
+            actor_token_type=actor_token_type,
+            additional_options=additional_options,
+            additional_headers=additional_headers,
+        )
+
+        with instrumentation._span("google.oauth2.sts.exchange_token"):
+            response = await request(
+                url=self._token_exchange_endpoint,
+                method="POST",
+                headers=headers,
+                body=request_body,
+            )
+            data = await response.content()
+
+        return self._handle_response(response.status, data)
+
+    async def exchange_tokens(
+        self,
+        request,
+        exchanges,
+        max_concurrency=_helpers.DEFAULT_MAX_CONCURRENCY,
+    ):
+        """Makes many token exchanges concurrently on the event loop.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+            exchanges (Sequence[Mapping[str, Any]]): The keyword arguments of
+                :meth:`exchange_token` for each exchange, except ``request``.
+            max_concurrency (int): The maximum number of exchanges in flight.
+
+        Returns:
+            Sequence[google.oauth2.sts.ExchangeResult]: The result of each
+                exchange, in the order given. A failed exchange doesn't
+                affect the others.
+
+        Raises:
+            ValueError: If ``max_concurrency`` is less than one.
+        """
+        _helpers.check_max_concurrency(max_concurrency)
+        semaphore = asyncio.Semaphore(max_concurrency)
+
+        async def exchange(kwargs):
+            async with semaphore:
+                try:
+                    return sts.ExchangeResult(
+                        response_data=await self.exchange_token(request, **kwargs)
+                    )
+                except Exception as caught_exc:  # pylint: disable=broad-except
+                    return sts.ExchangeResult(error=caught_exc)
+
+        with instrumentation._span("google.oauth2.sts.exchange_tokens"):
+            return list(
+                await asyncio.gather(*(exchange(kwargs) for kwargs in exchanges))
+            )
@@ -50,19 +50,38 @@ library like `CacheControl`_ to create a cache-aware
     cached_session = cachecontrol.CacheControl(session)
     request = google.auth.transport.requests.Request(session=cached_session)
 
+To mint ID tokens for several audiences, for example to call a number of
+services on each incoming request, use an :class:`IDTokenProvider`. It caches
+the tokens of every audience until shortly before they expire::
+
+    from google.oauth2 import id_token
+    from google.auth.transport import requests
+
+    request = requests.Request()
+    credentials = id_token.fetch_id_token_credentials(
+        'https://service-1.example.com', request=request)
+    provider = id_token.IDTokenProvider(credentials)
+
+    token = provider.get_token(request, 'https://service-2.example.com')
+
 .. _OpenID Connect ID Tokens:
     http://openid.net/specs/openid-connect-core-1_0.html#IDToken
 .. _CacheControl: https://cachecontrol.readthedocs.io
 """
 
+import datetime
 import json
+import logging
 import os
+import threading
 
 import six
 from six.moves import http_client
 
+from google.auth import _helpers
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import instrumentation
 from google.auth import jwt
 import google.auth.transport.requests
 
@@ -80,6 +99,12 @@ _GOOGLE_APIS_CERTS_URL = (
 
 _GOOGLE_ISSUERS = ["accounts.google.com", "https://accounts.google.com"]
 
+_LOGGER = logging.getLogger(__name__)
+
+# ID tokens about to expire are refreshed in the background while the current
+# one is still handed out. ID tokens are valid for one hour.
+_ID_TOKEN_REFRESH_AHEAD = datetime.timedelta(minutes=5)
+
 
 def _fetch_certs(request, certs_url):
     """Fetches certificates.
@@ -323,6 +348,11 @@ def fetch_id_token(request, audience):
 
         id_token = google.oauth2.id_token.fetch_id_token(request, target_audience)
 
+    The credentials are resolved once per process (again if
+    ``GOOGLE_APPLICATION_CREDENTIALS`` changes) and the ID tokens of every
+    audience are cached by an :class:`IDTokenProvider`, so calling this
+    function for every outgoing request is cheap.
+
     Args:
         request (google.auth.transport.Request): A callable used to make
             HTTP requests.
@@ -336,6 +366,144 @@ def fetch_id_token(request, audience):
             If metadata server doesn't exist and no valid service account
             credentials are found.
     """
-    id_token_credentials = fetch_id_token_credentials(audience, request=request)
-    id_token_credentials.refresh(request)
-    return id_token_credentials.token
+    return _get_id_token_provider(request, audience).get_token(request, audience)
+
+
+class _AudienceTokens(object):
+    """The ID token credentials and the latest token for one audience."""
+
+    def __init__(self, credentials):
+        self.credentials = credentials
+        # Held while refreshing, so that concurrent refreshes are coalesced.
+        self.lock = threading.Lock()
+        # The token and its expiry, read and replaced together.
+        self.token = (None, None)
+
+
+class IDTokenProvider(object):
+    """Mints and caches ID tokens for any number of audiences.
+
+    The tokens of each audience are cached until shortly before they expire.
+    Concurrent requests for an audience without a valid token share a single
+    refresh, and tokens about to expire are refreshed in the background while
+    the current one is still returned.
+
+    The provider is thread-safe.
+
+    Args:
+        credentials (Union[google.auth.compute_engine.IDTokenCredentials, \
+            google.oauth2.service_account.IDTokenCredentials]): ID token
+            credentials for any audience. The credentials for each audience
+            are derived from them with ``with_target_audience``.
+        refresh_ahead (datetime.timedelta): How long before expiring tokens
+            are refreshed in the background.
+    """
+
+    def __init__(self, credentials, refresh_ahead=_ID_TOKEN_REFRESH_AHEAD):
+        self._credentials = credentials
+        self._refresh_ahead = refresh_ahead
+        self._lock = threading.Lock()
+        self._audiences = {}
+
+    def _get_audience_tokens(self, audience):
+        tokens = self._audiences.get(audience)
+        if tokens is None:
+            with self._lock:
+                tokens = self._audiences.get(audience)
+                if tokens is None:
+                    tokens = _AudienceTokens(
+                        self._credentials.with_target_audience(audience)
+                    )
+                    self._audiences[audience] = tokens
+        return tokens
+
+    def get_token(self, request, audience):
+        """Gets an ID token for an audience, minting one if there is no valid
+        cached token.
+
+        Args:
+            request (google.auth.transport.Request): A callable used to make
+                HTTP requests.
+            audience (str): The audience that the ID token is intended for.
+
+        Returns:
+            str: The ID token.
+
+        Raises:
+            google.auth.exceptions.RefreshError: If a token could not be
+                minted.
+        """
+        tokens = self._get_audience_tokens(audience)
+        token, expiry = tokens.token
+        now = _helpers.utcnow()
+
+        if token is None or (
+            expiry is not None and now >= expiry - _helpers.REFRESH_THRESHOLD
+        ):
+            return self._refresh(tokens, request, token)
+
+        if expiry is not None and now >= expiry - self._refresh_ahead:
+            self._refresh_in_background(tokens, request)
+        return token
+
+    def _refresh(self, tokens, request, stale_token):
+        with tokens.lock:
+            token, _ = tokens.token
+            # Another thread refreshed the token while this one waited.
+            if token is not stale_token:
+                return token
+
+            instrumentation._traced_refresh(tokens.credentials, request)
+            tokens.token = (tokens.credentials.token, tokens.credentials.expiry)
+            return tokens.credentials.token
+
+    def _refresh_in_background(self, tokens, request):
+        # A refresh is already in flight.
+        if not tokens.lock.acquire(False):
+            return
+
+        thread = threading.Thread(
+            target=self._background_refresh, args=(tokens, request)
+        )
+        thread.daemon = True
+        try:
+            thread.start()
+        except Exception:
+            tokens.lock.release()
+            raise
+
+    def _background_refresh(self, tokens, request):
+        try:
+            instrumentation._traced_refresh(tokens.credentials, request)
+            tokens.token = (tokens.credentials.token, tokens.credentials.expiry)
+        except Exception as caught_exc:  # pylint: disable=broad-except
+            # The current token is still valid; the next call retries.
+            _LOGGER.warning(
+                "Refreshing an ID token ahead of expiry failed: %s", caught_exc
+            )
+        finally:
+            tokens.lock.release()
+
+
+_id_token_provider_lock = threading.Lock()
+# The GOOGLE_APPLICATION_CREDENTIALS value and the provider created for it.
+_id_token_provider = (None, None)
+
+
+def _get_id_token_provider(request, audience):
+    """Gets the process-wide ID token provider used by :func:`fetch_id_token`.
+
+    The credentials are resolved with :func:`fetch_id_token_credentials` on
+    first use, and again when ``GOOGLE_APPLICATION_CREDENTIALS`` changes.
+    """
+    global _id_token_provider
+    credentials_filename = os.environ.get(environment_vars.CREDENTIALS)
+    with _id_token_provider_lock:
+        filename, provider = _id_token_provider
+        if provider is None or filename != credentials_filename:
+            credentials = fetch_id_token_credentials(audience, request=request)
+            provider = IDTokenProvider(credentials)
+            # The credentials are already bound to this audience.
+            provider._audiences[audience] = _AudienceTokens(credentials)
+            _id_token_provider = (credentials_filename, provider)
+        return provider
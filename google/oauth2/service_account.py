@@ -172,6 +172,9 @@ class Credentials(
         self._always_use_jwt_access = always_use_jwt_access
 
         self._jwt_credentials = None
+        # The self-signed JWT credentials of each (audience, scopes), so that
+        # credentials shared by clients of different hosts keep one for each.
+        self._jwt_credentials_by_key = {}
 
         if additional_claims is not None:
             self._additional_claims = additional_claims
@@ -416,29 +419,63 @@ class Credentials(
     def _create_self_signed_jwt(self, audience):
         """Create a self-signed JWT from the credentials if requirements are met.
 
+        Calling this again with the same effective audience and scopes keeps
+        the existing self-signed JWT credentials, so a JWT that was already
+        minted is reused until it expires.
+
+        Args:
+            audience (str): The service URL. ``https://[API_ENDPOINT]/``
+        """
+        jwt_credentials = self._get_self_signed_jwt_credentials(audience)
+        if jwt_credentials is not None:
+            self._jwt_credentials = jwt_credentials
+
+    def _get_self_signed_jwt_credentials(self, audience):
+        """Returns the self-signed JWT credentials for an audience.
+
+        The JWT credentials are created once for each effective audience and
+        scopes, and kept for later calls.
+
         Args:
             audience (str): The service URL. ``https://[API_ENDPOINT]/``
+
+        Returns:
+            Optional[google.auth.jwt.Credentials]: The JWT credentials, or
+                None if a self-signed JWT doesn't apply to the audience.
         """
         # https://google.aip.dev/auth/4111
         if self._always_use_jwt_access:
             if self._scopes:
-                self._jwt_credentials = jwt.Credentials.from_signing_credentials(
-                    self, None, additional_claims={"scope": " ".join(self._scopes)}
-                )
+                audience, scopes = None, self._scopes
             elif audience:
-                self._jwt_credentials = jwt.Credentials.from_signing_credentials(
-                    self, audience
-                )
+                scopes = None
             elif self._default_scopes:
-                self._jwt_credentials = jwt.Credentials.from_signing_credentials(
+                audience, scopes = None, self._default_scopes
+            else:
+                return None
+        elif not self._scopes and audience:
+            scopes = None
+        else:
+            return None
+
+        key = (audience, tuple(scopes) if scopes else None)
+        jwt_credentials = self._jwt_credentials_by_key.get(key)
+        if jwt_credentials is None:
+            if scopes:
+                jwt_credentials = jwt.Credentials.from_signing_credentials(
                     self,
                     None,
-                    additional_claims={"scope": " ".join(self._default_scopes)},
+                    additional_claims={"scope": " ".join(scopes)},
+                    quota_project_id=self._quota_project_id,
                 )
-        elif not self._scopes and audience:
-            self._jwt_credentials = jwt.Credentials.from_signing_credentials(
-                self, audience
+            else:
+                jwt_credentials = jwt.Credentials.from_signing_credentials(
+                    self, audience, quota_project_id=self._quota_project_id
+                )
+            jwt_credentials = self._jwt_credentials_by_key.setdefault(
+                key, jwt_credentials
             )
+        return jwt_credentials
 
     @_helpers.copy_docstring(credentials.Signing)
     def sign_bytes(self, message):
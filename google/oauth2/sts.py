@@ -27,6 +27,10 @@ cannot be easily mapped to parameters defined in the RFC.
 The returned dictionary response will be based on the `rfc8693 section 2.2.1`_
 spec JSON response.
 
+Many exchanges can be made concurrently with :meth:`Client.exchange_tokens`,
+for example to downscope or federate tokens for many tenants. An asyncio
+client is available in :mod:`google.oauth2._sts_async`.
+
 .. _OAuth 2.0 Token Exchange: https://tools.ietf.org/html/rfc8693
 .. _rfc8693 section 2.2.1: https://tools.ietf.org/html/rfc8693#section-2.2.1
 """
@@ -36,12 +40,39 @@ import json
 from six.moves import http_client
 from six.moves import urllib
 
+from google.auth import _helpers
+from google.auth import instrumentation
 from google.oauth2 import utils
 
 
 _URLENCODED_HEADERS = {"Content-Type": "application/x-www-form-urlencoded"}
 
 
+class ExchangeResult(object):
+    """The outcome of one exchange made by :meth:`Client.exchange_tokens`.
+
+    Attributes:
+        response_data (Optional[Mapping[str, str]]): The token exchange
+            JSON-decoded response data, or None if the exchange failed.
+        error (Optional[Exception]): The error raised by the exchange, if
+            any.
+    """
+
+    def __init__(self, response_data=None, error=None):
+        self.response_data = response_data
+        self.error = error
+
+    @property
+    def ok(self):
+        """bool: Whether the exchange succeeded."""
+        return self.error is None
+
+    def __repr__(self):
+        return "ExchangeResult(response_data={!r}, error={!r})".format(
+            self.response_data, self.error
+        )
+
+
 class Client(utils.OAuthClientAuthHandler):
     """Implements the OAuth 2.0 token exchange spec based on
     https://tools.ietf.org/html/rfc8693.
@@ -58,6 +89,7 @@ class Client(utils.OAuthClientAuthHandler):
         super(Client, self).__init__(client_authentication)
         self._token_exchange_endpoint = token_exchange_endpoint
 
+    @instrumentation._traced("google.oauth2.sts.exchange_token")
     def exchange_token(
         self,
         request,
@@ -102,6 +134,83 @@ class Client(utils.OAuthClientAuthHandler):
             google.auth.exceptions.OAuthError: If the token endpoint returned
                 an error.
         """
+        headers, request_body = self._make_request(
+            grant_type,
+            subject_token,
+            subject_token_type,
+            resource=resource,
+            audience=audience,
+            scopes=scopes,
+            requested_token_type=requested_token_type,
+            actor_token=actor_token,
+            actor_token_type=actor_token_type,
+            additional_options=additional_options,
+            additional_headers=additional_headers,
+        )
+
+        # Execute request.
+        response = request(
+            url=self._token_exchange_endpoint,
+            method="POST",
+            headers=headers,
+            body=request_body,
+        )
+
+        return self._handle_response(response.status, response.data)
+
+    @instrumentation._traced("google.oauth2.sts.exchange_tokens")
+    def exchange_tokens(
+        self, request, exchanges, max_concurrency=_helpers.DEFAULT_MAX_CONCURRENCY
+    ):
+        """Makes many token exchanges concurrently.
+
+        The exchanges are made by a bounded number of worker threads, all
+        sharing ``request``. To reuse connections across exchanges, pass a
+        transport with a connection pool at least ``max_concurrency`` large,
+        such as :class:`google.auth.transport.requests.Request`.
+
+        Args:
+            request (google.auth.transport.Request): A thread-safe callable
+                used to make HTTP requests.
+            exchanges (Sequence[Mapping[str, Any]]): The keyword arguments of
+                :meth:`exchange_token` for each exchange, except ``request``.
+            max_concurrency (int): The maximum number of exchanges in flight.
+
+        Returns:
+            Sequence[ExchangeResult]: The result of each exchange, in the
+                order given. A failed exchange doesn't affect the others.
+
+        Raises:
+            ValueError: If ``max_concurrency`` is less than one.
+        """
+
+        def exchange(kwargs):
+            try:
+                return ExchangeResult(
+                    response_data=self.exchange_token(request, **kwargs)
+                )
+            except Exception as caught_exc:  # pylint: disable=broad-except
+                return ExchangeResult(error=caught_exc)
+
+        return _helpers.map_concurrently(
+            exchange, exchanges, max_concurrency, "google-auth-sts-exchange"
+        )
+
+    def _make_request(
+        self,
+        grant_type,
+        subject_token,
+        subject_token_type,
+        resource=None,
+        audience=None,
+        scopes=None,
+        requested_token_type=None,
+        actor_token=None,
+        actor_token_type=None,
+        additional_options=None,
+        additional_headers=None,
+    ):
+        """Returns the headers and the encoded body of an exchange request."""
         # Initialize request headers.
         headers = _URLENCODED_HEADERS.copy()
         # Inject additional headers.
@@ -131,22 +240,15 @@ class Client(utils.OAuthClientAuthHandler):
         # Apply OAuth client authentication.
         self.apply_client_authentication_options(headers, request_body)
 
-        # Execute request.
-        response = request(
-            url=self._token_exchange_endpoint,
-            method="POST",
-            headers=headers,
-            body=urllib.parse.urlencode(request_body).encode("utf-8"),
-        )
+        return headers, urllib.parse.urlencode(request_body).encode("utf-8")
 
-        response_body = (
-            response.data.decode("utf-8")
-            if hasattr(response.data, "decode")
-            else response.data
-        )
+    @staticmethod
+    def _handle_response(status, data):
+        """Returns the JSON-decoded data of an exchange response."""
+        response_body = data.decode("utf-8") if hasattr(data, "decode") else data
 
         # If non-200 response received, translate to OAuthError exception.
-        if response.status != http_client.OK:
+        if status != http_client.OK:
             utils.handle_error_response(response_body)
 
         response_data = json.loads(response_body)
@@ -25,6 +25,7 @@ CURRENT_DIRECTORY = pathlib.Path(__file__).parent.absolute()
 CLICK_VERSION = "click==8.0.4"
 BLACK_VERSION = "black==19.3b0"
 BLACK_PATHS = [
+    "benchmarks",
     "google",
     "tests",
     "tests_async",
@@ -140,6 +141,16 @@ def cover(session):
     session.run("coverage", "report", "--show-missing", "--fail-under=100")
 
 
+@nox.session(python="3.8")
+def benchmark(session):
+    """Run the micro-benchmarks in ``benchmarks/``."""
+    session.install("-r", "testing/requirements.txt")
+    session.install("-e", ".[aiohttp]")
+    for path in sorted((CURRENT_DIRECTORY / "benchmarks").glob("bench_*.py")):
+        session.log("Running %s", path.name)
+        session.run("python", str(path), *session.posargs)
+
+
 @nox.session(python="3.8")
 def docs(session):
     """Build the docs for this library."""
@@ -39,6 +39,7 @@ EXPLICIT_PROJECT_ENV = "GOOGLE_CLOUD_PROJECT"
 EXPECT_PROJECT_ENV = "EXPECT_PROJECT_ID"
 
 SKIP_GAE_TEST_ENV = "SKIP_APP_ENGINE_SYSTEM_TEST"
+FAKE_METADATA_SERVER_ENV = "GOOGLE_AUTH_FAKE_METADATA_SERVER"
 GAE_APP_URL_TMPL = "https://{}-dot-{}.appspot.com"
 GAE_TEST_APP_SERVICE = "google-auth-system-tests"
 
@@ -287,6 +288,21 @@ def compute_engine(session):
     )
 
 
+@nox.session(python=PYTHON_VERSIONS_SYNC)
+def compute_engine_fake_metadata(session):
+    session.install(*TEST_DEPENDENCIES_SYNC)
+    del session.virtualenv.env["GOOGLE_APPLICATION_CREDENTIALS"]
+    # Run the Compute Engine tests against the bundled fake metadata server
+    # instead of a real Compute Engine instance.
+    session.env[FAKE_METADATA_SERVER_ENV] = "1"
+    session.install(LIBRARY_DIR)
+    default(
+        session,
+        "system_tests_sync/test_compute_engine.py",
+        *session.posargs,
+    )
+
+
 @nox.session(python=["2.7"])
 def app_engine(session):
     if SKIP_GAE_TEST_ENV in os.environ:
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 from datetime import datetime
+import os
 
 import pytest
 
@@ -22,9 +23,21 @@ from google.auth import _helpers
 from google.auth import exceptions
 from google.auth import jwt
 from google.auth.compute_engine import _metadata
+from google.auth.compute_engine import fake_metadata_server
 import google.oauth2.id_token
 
 AUDIENCE = "https://pubsub.googleapis.com"
+# Set by the nox session running these tests against the fake metadata server.
+USE_FAKE_METADATA_SERVER = os.environ.get("GOOGLE_AUTH_FAKE_METADATA_SERVER") == "1"
+
+
+@pytest.fixture(scope="module", autouse=True)
+def metadata_server():
+    if not USE_FAKE_METADATA_SERVER:
+        yield None
+        return
+    with fake_metadata_server.FakeMetadataServer() as server:
+        yield server
 
 
 @pytest.fixture(autouse=True)
@@ -35,6 +48,7 @@ def check_gce_environment(http_request):
         pytest.skip("Compute Engine metadata service is not available.")
 
 
+@pytest.mark.skipif(USE_FAKE_METADATA_SERVER, reason="Fake tokens have no token info.")
 def test_refresh(http_request, token_info):
     credentials = compute_engine.Credentials()
 
@@ -73,3 +87,15 @@ def test_fetch_id_token(http_request):
 
     _, payload, _, _ = jwt._unverified_decode(token)
     assert payload["aud"] == AUDIENCE
+
+
+@pytest.mark.skipif(
+    not USE_FAKE_METADATA_SERVER, reason="Needs the fake metadata server."
+)
+def test_refresh_throttled(http_request, metadata_server):
+    metadata_server.inject_error(503, count=2, retry_after=0)
+    credentials = compute_engine.Credentials()
+
+    credentials.refresh(http_request)
+
+    assert credentials.valid
@@ -15,26 +15,41 @@
 import datetime
 import json
 import os
+import threading
 
 import mock
 import pytest  # type: ignore
+from six.moves import BaseHTTPServer as http_server
 from six.moves import http_client
 from six.moves import reload_module
 
 from google.auth import _helpers
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import instrumentation
 from google.auth import transport
 from google.auth.compute_engine import _metadata
+import google.auth.transport._http_client
 
 PATH = "instance/service-accounts/default"
 
 
-def make_request(data, status=http_client.OK, headers=None, retry=False):
+@pytest.fixture(autouse=True)
+def sleep():
+    with mock.patch("time.sleep", autospec=True) as sleep:
+        yield sleep
+
+
+def make_response(data, status=http_client.OK, headers=None):
     response = mock.create_autospec(transport.Response, instance=True)
     response.status = status
     response.data = _helpers.to_bytes(data)
     response.headers = headers or {}
+    return response
+
+
+def make_request(data, status=http_client.OK, headers=None, retry=False):
+    response = make_response(data, status=status, headers=headers)
 
     request = mock.create_autospec(transport.Request)
     if retry:
@@ -270,6 +285,163 @@ def test_get_failure_connection_failed():
     assert request.call_count == 5
 
 
+def test_ping_retry_throttled(sleep):
+    request = mock.create_autospec(transport.Request)
+    request.side_effect = [
+        make_response(
+            "", status=http_client.SERVICE_UNAVAILABLE, headers={"retry-after": "2"}
+        ),
+        make_response("", headers=_metadata._METADATA_HEADERS),
+    ]
+
+    assert _metadata.ping(request)
+
+    assert request.call_count == 2
+    sleep.assert_called_once_with(2.0)
+
+
+@mock.patch("google.auth._exponential_backoff._monotonic", autospec=True)
+def test_ping_deadline(time, sleep):
+    time.return_value = 0
+    request = make_request("")
+
+    def fail(**kwargs):
+        time.return_value += kwargs["timeout"]
+        raise exceptions.TransportError()
+
+    request.side_effect = fail
+
+    assert not _metadata.ping(request, timeout=3, retry_count=10, deadline=5)
+
+    # The second attempt only waits for the time left before the deadline.
+    assert [call[1]["timeout"] for call in request.call_args_list] == [3, 2]
+
+
+def test_get_retry_throttled(sleep):
+    request = mock.create_autospec(transport.Request)
+    request.side_effect = [
+        make_response("", status=429, headers={"retry-after": "1"}),
+        make_response("", status=http_client.SERVICE_UNAVAILABLE),
+        make_response("value", headers={"content-type": "text/plain"}),
+    ]
+
+    assert _metadata.get(request, PATH) == "value"
+
+    assert request.call_count == 3
+    assert sleep.call_args_list[0] == mock.call(1.0)
+    # Without Retry-After the delay is jittered below the backoff bound.
+    assert 0 <= sleep.call_args_list[1][0][0] <= _metadata._BACKOFF_INITIAL_DELAY * 2
+
+
+def test_get_throttled_exhausted():
+    request = make_request(
+        "Slow down", status=http_client.SERVICE_UNAVAILABLE, headers={}
+    )
+
+    with pytest.raises(exceptions.TransportError) as excinfo:
+        _metadata.get(request, PATH, retry_count=2)
+
+    assert excinfo.match(r"Slow down")
+    assert request.call_count == 2
+
+
+@mock.patch(
+    "google.auth._exponential_backoff._monotonic", return_value=0, autospec=True
+)
+def test_get_deadline(unused_time):
+    request = make_request(
+        "", status=http_client.SERVICE_UNAVAILABLE, headers={"retry-after": "30"}
+    )
+
+    with pytest.raises(exceptions.TransportError):
+        _metadata.get(request, PATH, deadline=5)
+
+    # Retrying after the capped Retry-After would miss the deadline, so there
+    # is one attempt.
+    request.assert_called_once_with(
+        method="GET",
+        url=_metadata._METADATA_ROOT + PATH,
+        headers=_metadata._METADATA_HEADERS,
+        timeout=5,
+    )
+
+
+def test_get_retry_after_capped(sleep):
+    request = mock.create_autospec(transport.Request)
+    request.side_effect = [
+        make_response("", status=429, headers={"retry-after": "3600"}),
+        make_response("value", headers={"content-type": "text/plain"}),
+    ]
+
+    assert _metadata.get(request, PATH) == "value"
+
+    sleep.assert_called_once_with(_metadata._BACKOFF_MAX_DELAY)
+
+
+def test_get_retry_instrumentation():
+    records = []
+
+    class Recorder(instrumentation.Instrumentation):
+        def record(self, name, duration, attributes, error=None):
+            records.append((name, attributes))
+
+    request = make_request("", headers={"content-type": "text/plain"}, retry=True)
+    instrumentation.set_instrumentation(Recorder())
+    try:
+        _metadata.get(request, PATH)
+    finally:
+        instrumentation.set_instrumentation(None)
+
+    assert (_metadata._BACKOFF_SPAN_NAME, {"attempt": "2"}) in records
+
+
+class FaultInjectingHandler(http_server.BaseHTTPRequestHandler):
+    """Throttles the first requests, then serves the metadata."""
+
+    faults = 2
+
+    def do_GET(self):
+        self.server.requests += 1
+        if self.server.requests <= self.faults:
+            self.send_response(http_client.SERVICE_UNAVAILABLE)
+            self.send_header("Retry-After", "0")
+            self.end_headers()
+            return
+        self.send_response(http_client.OK)
+        self.send_header("Content-Type", "text/plain")
+        self.send_header(_metadata._METADATA_FLAVOR_HEADER, "Google")
+        self.end_headers()
+        self.wfile.write(b"example-project")
+
+    def log_message(self, format, *args):
+        pass
+
+
+@pytest.fixture
+def fault_injecting_server():
+    server = http_server.HTTPServer(("localhost", 0), FaultInjectingHandler)
+    server.requests = 0
+    thread = threading.Thread(target=server.serve_forever)
+    thread.daemon = True
+    thread.start()
+    yield server
+    server.shutdown()
+    server.server_close()
+
+
+def test_get_fault_injecting_server(fault_injecting_server, sleep):
+    root = "http://localhost:{}/computeMetadata/v1/".format(
+        fault_injecting_server.server_address[1]
+    )
+    request = google.auth.transport._http_client.Request()
+
+    assert _metadata.get(request, "project/project-id", root=root) == (
+        "example-project"
+    )
+    assert fault_injecting_server.requests == 3
+    assert sleep.call_count == 2
+
+
 def test_get_failure_bad_json():
     request = make_request("{", headers={"content-type": "application/json"})
 
@@ -371,3 +543,106 @@ def test_get_service_account_info():
     )
 
     assert info[key] == value
+
+
+def make_token_request(*tokens):
+    responses = [
+        make_response(
+            json.dumps({"access_token": token, "expires_in": 3600}),
+            headers={"content-type": "application/json"},
+        )
+        for token in tokens
+    ]
+    return mock.create_autospec(transport.Request, side_effect=responses)
+
+
+class TestTokenBroker(object):
+    def test_canonical_scopes(self):
+        assert _metadata._canonical_scopes(None) == ()
+        assert _metadata._canonical_scopes([]) == ()
+        assert _metadata._canonical_scopes(["b", "a", "b"]) == ("a", "b")
+        assert _metadata._canonical_scopes("b, a") == ("a", "b")
+
+    def test_get_token_cached_by_scope_set(self):
+        broker = _metadata._TokenBroker()
+        request = make_token_request("token")
+
+        token, expiry = broker.get_token(request, scopes=["b", "a"])
+
+        assert token == "token"
+        assert broker.get_token(request, scopes="a,b") == (token, expiry)
+        # The first request decides the order of the scopes sent.
+        request.assert_called_once_with(
+            method="GET",
+            url=_metadata._METADATA_ROOT + PATH + "/token?scopes=b%2Ca",
+            headers=_metadata._METADATA_HEADERS,
+        )
+
+    def test_get_token_per_identity(self):
+        broker = _metadata._TokenBroker()
+        request = make_token_request("default", "other", "scoped")
+
+        assert broker.get_token(request)[0] == "default"
+        assert broker.get_token(request, "other@example.com")[0] == "other"
+        assert broker.get_token(request, scopes=["a"])[0] == "scoped"
+        assert broker.get_token(request)[0] == "default"
+        assert request.call_count == 3
+
+    def test_get_token_stale(self):
+        broker = _metadata._TokenBroker()
+        request = make_token_request("token", "new-token")
+
+        broker.get_token(request)
+
+        assert broker.get_token(request, stale_token="token")[0] == "new-token"
+        assert broker.get_token(request, stale_token="token")[0] == "new-token"
+        assert request.call_count == 2
+
+    def test_get_token_expired(self):
+        broker = _metadata._TokenBroker()
+        request = make_token_request("token", "new-token")
+        broker.get_token(request)
+
+        expiring = _helpers.utcnow() + datetime.timedelta(seconds=3590)
+        with mock.patch("google.auth._helpers.utcnow", return_value=expiring):
+            assert broker.get_token(request)[0] == "new-token"
+
+    def test_get_token_concurrent(self):
+        broker = _metadata._TokenBroker()
+        response = make_response(
+            json.dumps({"access_token": "token", "expires_in": 3600}),
+            headers={"content-type": "application/json"},
+        )
+        in_flight = threading.Event()
+        release = threading.Event()
+
+        def request(**kwargs):
+            in_flight.set()
+            release.wait(timeout=5)
+            return response
+
+        request = mock.Mock(side_effect=request)
+        results = []
+        threads = [
+            threading.Thread(target=lambda: results.append(broker.get_token(request)))
+            for _ in range(5)
+        ]
+        threads[0].start()
+        in_flight.wait(timeout=5)
+        for thread in threads[1:]:
+            thread.start()
+        release.set()
+        for thread in threads:
+            thread.join(timeout=5)
+
+        assert request.call_count == 1
+        assert [token for token, _ in results] == ["token"] * 5
+
+    def test_clear(self):
+        broker = _metadata._TokenBroker()
+        request = make_token_request("token", "new-token")
+        broker.get_token(request)
+
+        broker.clear()
+
+        assert broker.get_token(request)[0] == "new-token"
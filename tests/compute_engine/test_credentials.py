@@ -22,6 +22,7 @@ from google.auth import _helpers
 from google.auth import exceptions
 from google.auth import jwt
 from google.auth import transport
+from google.auth.compute_engine import _metadata
 from google.auth.compute_engine import credentials
 from google.auth.transport import requests
 
@@ -135,6 +136,95 @@ class TestCredentials(object):
         kwargs = get.call_args[1]
         assert kwargs == {"params": {"scopes": "three,four"}}
 
+    @mock.patch("google.auth.compute_engine._metadata.get", autospec=True)
+    def test_refresh_retrieves_info_once(self, get):
+        info = {"email": "service-account@example.com", "scopes": ["one", "two"]}
+        token = {"access_token": "token", "expires_in": 500}
+        get.side_effect = [info, token, token]
+
+        self.credentials.refresh(None)
+        self.credentials.refresh(None)
+
+        # The second refresh only fetches a token.
+        assert get.call_count == 3
+        assert get.call_args[0][1] == (
+            "instance/service-accounts/service-account@example.com/token"
+        )
+        assert self.credentials.service_account_email == "service-account@example.com"
+
+    @mock.patch("google.auth.compute_engine._metadata.get", autospec=True)
+    def test_invalidate_service_account_info(self, get):
+        token = {"access_token": "token", "expires_in": 500}
+        get.side_effect = [
+            {"email": "service-account@example.com", "scopes": ["one", "two"]},
+            token,
+            {"email": "service-account@example.com", "scopes": ["three"]},
+            token,
+        ]
+
+        self.credentials.refresh(None)
+        self.credentials.invalidate_service_account_info()
+        assert self.credentials._scopes is None
+
+        self.credentials.refresh(None)
+
+        assert get.call_count == 4
+        assert self.credentials._scopes == ["three"]
+
+    @mock.patch("google.auth.compute_engine._metadata.get", autospec=True)
+    def test_invalidate_service_account_info_keeps_user_scopes(self, get):
+        self.credentials = self.credentials.with_scopes(["user"])
+        get.side_effect = [
+            {"email": "service-account@example.com", "scopes": ["one", "two"]},
+            {"access_token": "token", "expires_in": 500},
+        ]
+
+        self.credentials.refresh(None)
+        self.credentials.invalidate_service_account_info()
+
+        assert self.credentials._scopes == ["user"]
+        assert not self.credentials._info_retrieved
+
+    @mock.patch("google.auth.compute_engine._metadata.get", autospec=True)
+    def test_refresh_shares_token_between_scoped_copies(self, get):
+        get.side_effect = [
+            {"email": "service-account@example.com", "scopes": ["one"]},
+            {"access_token": "token", "expires_in": 500},
+            {"email": "service-account@example.com", "scopes": ["one"]},
+        ]
+        first = self.credentials.with_scopes(["one", "two"])
+        second = self.credentials.with_scopes(["two", "one"]).with_quota_project(
+            "project"
+        )
+
+        first.refresh(None)
+        second.refresh(None)
+
+        assert second.token == first.token == "token"
+        assert second.expiry == first.expiry
+        # Each copy retrieves the service account info once, but the token
+        # is only fetched once.
+        assert [call[0][1] for call in get.call_args_list] == [
+            "instance/service-accounts/default/",
+            "instance/service-accounts/service-account@example.com/token",
+            "instance/service-accounts/default/",
+        ]
+
+    @mock.patch("google.auth.compute_engine._metadata.get", autospec=True)
+    def test_refresh_replaces_current_token(self, get):
+        get.side_effect = [
+            {"email": "service-account@example.com", "scopes": ["one"]},
+            {"access_token": "token", "expires_in": 500},
+            {"access_token": "new-token", "expires_in": 500},
+        ]
+        self.credentials.refresh(None)
+
+        # A refresh while the token is valid, such as after a 401, fetches a
+        # new token instead of returning the shared one.
+        self.credentials.refresh(None)
+
+        assert self.credentials.token == "new-token"
+
     @mock.patch("google.auth.compute_engine._metadata.get", autospec=True)
     def test_refresh_error(self, get):
         get.side_effect = exceptions.TransportError("http error")
@@ -0,0 +1,316 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import threading
+import time
+
+import mock
+import pytest  # type: ignore
+from six.moves import http_client
+from six.moves import queue
+
+from google.auth import environment_vars
+from google.auth import exceptions
+from google.auth import jwt
+from google.auth.compute_engine import _metadata
+from google.auth.compute_engine import credentials
+from google.auth.compute_engine import fake_metadata_server
+from google.auth.compute_engine import watch
+import google.auth.transport.requests
+
+EMAIL = "service-account@example.com"
+
+
+@pytest.fixture
+def server():
+    with fake_metadata_server.FakeMetadataServer(
+        project_id="my-project", service_account_email=EMAIL
+    ) as server:
+        yield server
+
+
+@pytest.fixture
+def request_():
+    return google.auth.transport.requests.Request()
+
+
+@pytest.fixture(autouse=True)
+def no_sleep():
+    with mock.patch("time.sleep", autospec=True):
+        yield
+
+
+def raw_get(request, server, path, headers=_metadata._METADATA_HEADERS):
+    return request(
+        url="http://{}/computeMetadata/v1/{}".format(server.host, path),
+        method="GET",
+        headers=headers,
+    )
+
+
+def test_install(server, request_):
+    assert os.environ[environment_vars.GCE_METADATA_HOST] == server.host
+    assert os.environ[environment_vars.GCE_METADATA_IP] == server.host
+    assert _metadata._METADATA_ROOT == "http://{}/computeMetadata/v1/".format(
+        server.host
+    )
+    assert _metadata.ping(request_)
+
+
+def test_close_uninstalls():
+    root, ip_root = _metadata._METADATA_ROOT, _metadata._METADATA_IP_ROOT
+    environ = dict(os.environ)
+
+    with fake_metadata_server.FakeMetadataServer():
+        pass
+
+    assert _metadata._METADATA_ROOT == root
+    assert _metadata._METADATA_IP_ROOT == ip_root
+    assert dict(os.environ) == environ
+
+
+def test_project_and_attributes(server, request_):
+    server.set("instance/attributes/my-key", "value")
+    server.set("project/attributes/other-key", "other")
+
+    assert _metadata.get_project_id(request_) == "my-project"
+    assert _metadata.get(request_, "instance/attributes/my-key") == "value"
+    assert _metadata.get(request_, "project/attributes/other-key") == "other"
+    assert _metadata.get(request_, "instance/attributes/") == "my-key"
+    assert _metadata.get(request_, "project/numeric-project-id") == "123456789012"
+
+    server.delete("instance/attributes/my-key")
+    with pytest.raises(exceptions.TransportError) as excinfo:
+        _metadata.get(request_, "instance/attributes/my-key")
+    assert excinfo.value.args[1].status == http_client.NOT_FOUND
+
+
+def test_recursive(server, request_):
+    server.set("instance/attributes/my-key", "value")
+
+    instance = _metadata.get(request_, "instance/", recursive=True)
+
+    # Names defined by the metadata server are camel cased, not user ones.
+    assert instance["maintenanceEvent"] == "NONE"
+    assert instance["attributes"] == {"my-key": "value"}
+    assert sorted(instance["serviceAccounts"]) == ["default", EMAIL]
+    assert _metadata.get(request_, "instance/attributes/", recursive=True) == {
+        "my-key": "value"
+    }
+
+
+def test_service_account_info(server, request_):
+    info = _metadata.get_service_account_info(request_)
+
+    assert info["email"] == EMAIL
+    assert info["aliases"] == ["default"]
+    assert _metadata.get_service_account_info(request_, EMAIL) == info
+
+
+def test_directory_redirect(server, request_):
+    response = raw_get(request_, server, "instance/attributes")
+
+    assert response.status == http_client.OK
+    assert server.requests == [
+        "/computeMetadata/v1/instance/attributes",
+        "/computeMetadata/v1/instance/attributes/",
+    ]
+
+
+def test_missing_flavor_header(server, request_):
+    response = raw_get(request_, server, "project/project-id", headers={})
+
+    assert response.status == http_client.FORBIDDEN
+
+
+def test_not_found(server, request_):
+    assert raw_get(request_, server, "missing").status == http_client.NOT_FOUND
+    response = request_(
+        url="http://{}/other".format(server.host),
+        method="GET",
+        headers=_metadata._METADATA_HEADERS,
+    )
+    assert response.status == http_client.NOT_FOUND
+
+
+def test_access_token(server, request_):
+    token, expiry = _metadata.get_service_account_token(request_, scopes=["scope"])
+    other, _ = _metadata.get_service_account_token(request_, EMAIL)
+
+    assert token.startswith("fake-access-token-")
+    assert token != other
+    assert expiry is not None
+    assert server.requests[0].endswith("/token?scopes=scope")
+
+
+def test_access_token_unknown_service_account(server, request_):
+    with pytest.raises(exceptions.TransportError):
+        _metadata.get_service_account_token(request_, "unknown@example.com")
+
+
+def test_credentials(server, request_):
+    creds = credentials.Credentials()
+
+    creds.refresh(request_)
+
+    assert creds.token.startswith("fake-access-token-")
+    assert creds.service_account_email == EMAIL
+
+
+def test_id_token(server, request_):
+    creds = credentials.IDTokenCredentials(
+        request_, "https://audience", use_metadata_identity_endpoint=True
+    )
+
+    creds.refresh(request_)
+
+    _, payload, _, signature = jwt._unverified_decode(creds.token)
+    assert payload["aud"] == "https://audience"
+    assert payload["email"] == EMAIL
+    assert signature == b"fake-signature"
+
+
+def test_id_token_standard_format(server, request_):
+    token = _metadata.get(
+        request_,
+        "instance/service-accounts/default/identity",
+        params={"audience": "https://audience"},
+    )
+
+    assert "email" not in jwt._unverified_decode(token)[1]
+
+
+def test_id_token_missing_audience(server, request_):
+    response = raw_get(request_, server, "instance/service-accounts/default/identity")
+
+    assert response.status == http_client.BAD_REQUEST
+
+
+def test_id_token_signed(request_):
+    signer = mock.Mock(key_id="key-id", spec=["sign", "key_id"])
+    signer.sign.return_value = b"signature"
+
+    with fake_metadata_server.FakeMetadataServer(signer=signer) as server:
+        token = raw_get(
+            request_,
+            server,
+            "instance/service-accounts/default/identity?audience=aud",
+        ).data
+
+    header, payload, _, signature = jwt._unverified_decode(token)
+    assert header["kid"] == "key-id"
+    assert payload["aud"] == "aud"
+    assert signature == b"signature"
+
+
+def test_inject_error(server, request_):
+    server.inject_error(http_client.SERVICE_UNAVAILABLE, count=2, retry_after=1)
+
+    assert _metadata.get_project_id(request_) == "my-project"
+    assert len(server.requests) == 3
+    time.sleep.assert_called_with(1)
+
+
+def test_inject_error_path(server, request_):
+    server.inject_error(
+        http_client.INTERNAL_SERVER_ERROR, path="/computeMetadata/v1/project/"
+    )
+
+    assert _metadata.get(request_, "instance/maintenance-event") == "NONE"
+    with pytest.raises(exceptions.TransportError):
+        _metadata.get_project_id(request_)
+    assert _metadata.get_project_id(request_) == "my-project"
+
+
+def test_inject_connection_failure(server, request_):
+    server.inject_error(None)
+
+    assert _metadata.get_project_id(request_) == "my-project"
+    assert len(server.requests) == 2
+
+
+def test_latency(request_):
+    with fake_metadata_server.FakeMetadataServer(latency=0.5) as server:
+        _metadata.get_project_id(request_)
+
+    time.sleep.assert_called_once_with(0.5)
+    assert server.latency == 0.5
+
+
+def test_wait_for_change(server, request_):
+    first = raw_get(request_, server, "instance/attributes/?recursive=true")
+    etag = first.headers["etag"]
+    responses = []
+
+    def wait():
+        responses.append(
+            raw_get(
+                request_,
+                server,
+                "instance/attributes/?recursive=true&wait_for_change=true"
+                "&last_etag={}".format(etag),
+            )
+        )
+
+    thread = threading.Thread(target=wait)
+    thread.start()
+    # The unrelated change doesn't end the long-poll.
+    server.set("project/attributes/key", "value")
+    server.set("instance/attributes/my-key", "value")
+    thread.join(timeout=5)
+
+    assert responses[0].data == b'{"my-key": "value"}'
+    assert responses[0].headers["etag"] != etag
+
+
+def test_wait_for_change_timeout(server, request_):
+    etag = raw_get(request_, server, "project/project-id").headers["etag"]
+
+    response = raw_get(
+        request_,
+        server,
+        "project/project-id?wait_for_change=true&timeout_sec=0&last_etag=" + etag,
+    )
+
+    assert response.data == b"my-project"
+    assert response.headers["etag"] == etag
+
+
+def test_watch(server):
+    changes = queue.Queue()
+
+    with watch.Watcher(timeout_sec=5) as watcher:
+        watcher.subscribe(
+            "instance/attributes/my-key", lambda path, value: changes.put(value)
+        )
+        assert changes.get(timeout=5) is None
+        server.set("instance/attributes/my-key", "value")
+        assert changes.get(timeout=5) == "value"
+
+
+def test_main(capsys):
+    server = fake_metadata_server.FakeMetadataServer()
+
+    with mock.patch.object(
+        fake_metadata_server, "FakeMetadataServer", return_value=server
+    ) as server_class, mock.patch.object(
+        server._server, "serve_forever", side_effect=KeyboardInterrupt
+    ):
+        fake_metadata_server.main(["--port", "0", "--latency", "0.1"])
+
+    assert server_class.call_args[1]["latency"] == 0.1
+    out = capsys.readouterr().out
+    assert "GCE_METADATA_HOST={}".format(server.host) in out
+    assert "GCE_METADATA_IP={}".format(server.host) in out
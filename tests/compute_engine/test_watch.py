@@ -0,0 +1,228 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+
+import mock
+import pytest  # type: ignore
+from six.moves import http_client
+from six.moves import queue
+from six.moves.urllib import parse as urlparse
+
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth import transport
+from google.auth.compute_engine import watch
+
+ROOT = "http://metadata.google.internal/computeMetadata/v1/"
+INSTANCE = {
+    "attributes": {"my-key": "value", "other-key": "other"},
+    "maintenanceEvent": "NONE",
+    "serviceAccounts": {"default": {"scopes": ["scope"]}},
+}
+
+
+def make_response(tree, etag, status=http_client.OK):
+    response = mock.create_autospec(transport.Response, instance=True)
+    response.status = status
+    response.data = _helpers.to_bytes(json.dumps(tree))
+    response.headers = {"etag": etag}
+    return response
+
+
+class FakeMetadataServer(object):
+    """Answers long-polls from per-directory queues, blocking while a queue is
+    empty like the metadata server does until a change happens."""
+
+    def __init__(self):
+        self.queues = {"instance": queue.Queue(), "project": queue.Queue()}
+        self.urls = queue.Queue()
+
+    def push(self, directory, response):
+        self.queues[directory].put(response)
+
+    def __call__(self, url, method, headers, timeout):
+        self.urls.put(url)
+        directory = urlparse.urlsplit(url).path.split("/")[3]
+        response = self.queues[directory].get()
+        if isinstance(response, Exception):
+            raise response
+        return response
+
+
+class Recorder(object):
+    def __init__(self):
+        self.calls = queue.Queue()
+
+    def __call__(self, path, value):
+        self.calls.put((path, value))
+
+    def next(self):
+        return self.calls.get(timeout=5)
+
+
+@pytest.fixture
+def server():
+    return FakeMetadataServer()
+
+
+@pytest.fixture
+def watcher(server):
+    watcher = watch.Watcher(request=server, timeout_sec=30, root=ROOT)
+    yield watcher
+    watcher.close()
+
+
+def query(url):
+    return dict(urlparse.parse_qsl(urlparse.urlsplit(url).query))
+
+
+def test_lookup():
+    assert watch._lookup(INSTANCE, ["attributes", "my-key"]) == "value"
+    assert watch._lookup(INSTANCE, ["maintenance-event"]) == "NONE"
+    assert watch._lookup(INSTANCE, ["service-accounts", "default", "scopes"]) == [
+        "scope"
+    ]
+    assert watch._lookup(INSTANCE, ["attributes"]) == INSTANCE["attributes"]
+    assert watch._lookup(INSTANCE, ["attributes", "missing"]) is None
+    assert watch._lookup(INSTANCE, ["maintenance-event", "child"]) is None
+
+
+def test_subscribe(server, watcher):
+    recorder = Recorder()
+    server.push("instance", make_response(INSTANCE, "etag1"))
+
+    watcher.subscribe("instance/attributes/my-key", recorder)
+    watcher.subscribe("instance/maintenance-event", recorder)
+
+    assert set([recorder.next(), recorder.next()]) == set(
+        [
+            ("instance/attributes/my-key", "value"),
+            ("instance/maintenance-event", "NONE"),
+        ]
+    )
+    first_url = server.urls.get(timeout=5)
+    assert first_url.startswith(ROOT + "instance/?")
+    assert query(first_url) == {"recursive": "true"}
+
+    changed = dict(INSTANCE, maintenanceEvent="MIGRATE_ON_HOST_MAINTENANCE")
+    server.push("instance", make_response(changed, "etag2"))
+
+    # Only the subscription whose value changed is called back.
+    assert recorder.next() == (
+        "instance/maintenance-event",
+        "MIGRATE_ON_HOST_MAINTENANCE",
+    )
+    assert query(server.urls.get(timeout=5)) == {
+        "recursive": "true",
+        "wait_for_change": "true",
+        "last_etag": "etag1",
+        "timeout_sec": "30",
+    }
+    assert query(server.urls.get(timeout=5))["last_etag"] == "etag2"
+    assert recorder.calls.empty()
+
+
+def test_subscribe_multiplexed(server, watcher):
+    recorder = Recorder()
+    server.push("instance", make_response(INSTANCE, "etag1"))
+    server.push("project", make_response({"projectId": "example"}, "etag1"))
+
+    watcher.subscribe("instance/attributes/my-key", recorder)
+    recorder.next()
+    # A path in a watched directory gets the known value without a request.
+    watcher.subscribe("instance/attributes/other-key", recorder)
+    assert recorder.next() == ("instance/attributes/other-key", "other")
+    watcher.subscribe("project/project-id", recorder)
+    assert recorder.next() == ("project/project-id", "example")
+
+    assert sorted(watcher._directories) == ["instance", "project"]
+    urls = [server.urls.get(timeout=5) for _ in range(4)]
+    # One initial request and one long-poll in flight per directory.
+    assert sorted(urlparse.urlsplit(url).path for url in urls) == [
+        "/computeMetadata/v1/instance/",
+        "/computeMetadata/v1/instance/",
+        "/computeMetadata/v1/project/",
+        "/computeMetadata/v1/project/",
+    ]
+
+
+@mock.patch("random.uniform", return_value=0, autospec=True)
+def test_backoff(uniform, server, watcher):
+    recorder = Recorder()
+    server.push("instance", exceptions.TransportError("unavailable"))
+    server.push(
+        "instance", make_response({}, "", status=http_client.SERVICE_UNAVAILABLE)
+    )
+    server.push("instance", make_response(INSTANCE, "etag1"))
+
+    watcher.subscribe("instance/attributes/my-key", recorder)
+
+    assert recorder.next() == ("instance/attributes/my-key", "value")
+    assert uniform.call_args_list == [
+        mock.call(0, watch._INITIAL_BACKOFF),
+        mock.call(0, watch._INITIAL_BACKOFF * 2),
+    ]
+
+
+def test_callback_error(server, watcher):
+    recorder = Recorder()
+    server.push("instance", make_response(INSTANCE, "etag1"))
+    watcher.subscribe("instance/attributes/my-key", mock.Mock(side_effect=ValueError))
+    watcher.subscribe("instance/attributes/other-key", recorder)
+
+    assert recorder.next() == ("instance/attributes/other-key", "other")
+
+
+def test_cancel(server, watcher):
+    recorder = Recorder()
+    server.push("instance", make_response(INSTANCE, "etag1"))
+    subscription = watcher.subscribe("instance/attributes/my-key", recorder)
+    recorder.next()
+
+    subscription.cancel()
+    changed = dict(INSTANCE, attributes={"my-key": "changed"})
+    server.push("instance", make_response(changed, "etag2"))
+
+    # The directory watch stops once it has no subscriptions left.
+    watcher._directories["instance"]._thread.join(timeout=5)
+    assert "instance" not in watcher._directories
+    assert recorder.calls.empty()
+
+
+def test_close(server, watcher):
+    watcher.close()
+
+    with pytest.raises(ValueError):
+        watcher.subscribe("instance/attributes/my-key", Recorder())
+
+
+@pytest.mark.parametrize("path", ["", "/", None, "computeMetadata/v1", "instances/id"])
+def test_subscribe_invalid_path(watcher, path):
+    with pytest.raises(ValueError):
+        watcher.subscribe(path, Recorder())
+
+    assert not watcher._directories
+
+
+def test_context_manager(server):
+    with watch.Watcher(request=server, root=ROOT) as watcher:
+        pass
+
+    assert watcher._closed.is_set()
+
+
+@mock.patch("google.auth.transport._http_client.Request", autospec=True)
+def test_default_request(request_class):
+    assert watch.Watcher()._request == request_class.return_value
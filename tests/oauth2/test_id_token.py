@@ -12,14 +12,18 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import datetime
 import json
 import os
+import threading
 
 import mock
 import pytest  # type: ignore
 
+from google.auth import _helpers
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import jwt
 from google.auth import transport
 from google.oauth2 import id_token
 from google.oauth2 import service_account
@@ -30,6 +34,13 @@ SERVICE_ACCOUNT_FILE = os.path.join(
 ID_TOKEN_AUDIENCE = "https://pubsub.googleapis.com"
 
 
+@pytest.fixture(autouse=True)
+def reset_id_token_provider():
+    id_token._id_token_provider = (None, None)
+    yield
+    id_token._id_token_provider = (None, None)
+
+
 def make_request(status, data=None):
     response = mock.create_autospec(transport.Response, instance=True)
     response.status = status
@@ -309,3 +320,154 @@ def test_fetch_id_token(monkeypatch):
     mock_fetch.assert_called_once_with(ID_TOKEN_AUDIENCE, request=mock_req)
     mock_cred.refresh.assert_called_once_with(mock_req)
     assert token == "token"
+
+
+def test_fetch_id_token_memoized(monkeypatch):
+    monkeypatch.setenv(environment_vars.CREDENTIALS, SERVICE_ACCOUNT_FILE)
+    credentials = IDTokenCredentialsStub(ID_TOKEN_AUDIENCE)
+
+    with mock.patch(
+        "google.oauth2.id_token.fetch_id_token_credentials", return_value=credentials
+    ) as fetch:
+        for _ in range(3):
+            assert (
+                id_token.fetch_id_token(mock.sentinel.request, ID_TOKEN_AUDIENCE)
+                == ID_TOKEN_AUDIENCE + "-1"
+            )
+            assert id_token.fetch_id_token(mock.sentinel.request, "a") == "a-1"
+
+        fetch.assert_called_once_with(ID_TOKEN_AUDIENCE, request=mock.sentinel.request)
+        assert credentials.refresh_count == 1
+
+        # The credentials are resolved again for other credentials.
+        monkeypatch.delenv(environment_vars.CREDENTIALS)
+        id_token.fetch_id_token(mock.sentinel.request, "a")
+
+        assert fetch.call_count == 2
+
+
+def test_fetch_id_token_error_not_memoized():
+    with mock.patch(
+        "google.oauth2.id_token.fetch_id_token_credentials",
+        side_effect=[exceptions.DefaultCredentialsError(), IDTokenCredentialsStub("a")],
+    ):
+        with pytest.raises(exceptions.DefaultCredentialsError):
+            id_token.fetch_id_token(mock.sentinel.request, "a")
+
+        assert id_token.fetch_id_token(mock.sentinel.request, "a") == "a-1"
+
+
+class IDTokenCredentialsStub(object):
+    def __init__(self, audience=None, lifetime=datetime.timedelta(hours=1)):
+        self.audience = audience
+        self.lifetime = lifetime
+        self.token = None
+        self.expiry = None
+        self.refresh_count = 0
+        self.refresh_side_effect = None
+
+    def with_target_audience(self, audience):
+        return IDTokenCredentialsStub(audience, lifetime=self.lifetime)
+
+    def refresh(self, request):
+        if self.refresh_side_effect is not None:
+            self.refresh_side_effect()
+        self.refresh_count += 1
+        self.token = "{}-{}".format(self.audience, self.refresh_count)
+        self.expiry = _helpers.utcnow() + self.lifetime
+
+
+def wait_for_background_refresh(provider, audience):
+    lock = provider._audiences[audience].lock
+    lock.acquire()
+    lock.release()
+
+
+class TestIDTokenProvider(object):
+    def test_get_token(self):
+        provider = id_token.IDTokenProvider(IDTokenCredentialsStub())
+
+        assert provider.get_token(mock.sentinel.request, "a") == "a-1"
+        assert provider.get_token(mock.sentinel.request, "a") == "a-1"
+        assert provider.get_token(mock.sentinel.request, "b") == "b-1"
+
+        assert provider._audiences["a"].credentials.refresh_count == 1
+
+    def test_get_token_expired(self):
+        provider = id_token.IDTokenProvider(IDTokenCredentialsStub())
+        provider.get_token(mock.sentinel.request, "a")
+        provider._audiences["a"].token = ("a-1", _helpers.utcnow())
+
+        assert provider.get_token(mock.sentinel.request, "a") == "a-2"
+
+    def test_get_token_refresh_ahead(self):
+        provider = id_token.IDTokenProvider(
+            IDTokenCredentialsStub(lifetime=datetime.timedelta(minutes=3))
+        )
+
+        # The token expires within the refresh-ahead window, but is returned
+        # while a new one is minted in the background.
+        assert provider.get_token(mock.sentinel.request, "a") == "a-1"
+        assert provider.get_token(mock.sentinel.request, "a") == "a-1"
+        wait_for_background_refresh(provider, "a")
+
+        assert provider._audiences["a"].token[0] == "a-2"
+
+    def test_get_token_refresh_ahead_failure(self):
+        provider = id_token.IDTokenProvider(
+            IDTokenCredentialsStub(lifetime=datetime.timedelta(minutes=3))
+        )
+        provider.get_token(mock.sentinel.request, "a")
+        credentials = provider._audiences["a"].credentials
+        credentials.refresh_side_effect = mock.Mock(
+            side_effect=exceptions.RefreshError()
+        )
+
+        assert provider.get_token(mock.sentinel.request, "a") == "a-1"
+        wait_for_background_refresh(provider, "a")
+
+        assert provider._audiences["a"].token[0] == "a-1"
+
+    def test_get_token_coalesced(self):
+        provider = id_token.IDTokenProvider(IDTokenCredentialsStub())
+        provider._get_audience_tokens("a")
+        released = threading.Event()
+        credentials = provider._audiences["a"].credentials
+        credentials.refresh_side_effect = lambda: released.wait(5)
+        tokens = []
+
+        threads = [
+            threading.Thread(
+                target=lambda: tokens.append(
+                    provider.get_token(mock.sentinel.request, "a")
+                )
+            )
+            for _ in range(10)
+        ]
+        for thread in threads:
+            thread.start()
+        released.set()
+        for thread in threads:
+            thread.join()
+
+        assert tokens == ["a-1"] * 10
+        assert credentials.refresh_count == 1
+
+    @mock.patch("google.oauth2._client.id_token_jwt_grant", autospec=True)
+    def test_service_account_credentials(self, id_token_jwt_grant):
+        expiry = _helpers.utcnow() + datetime.timedelta(hours=1)
+        id_token_jwt_grant.side_effect = lambda request, token_uri, assertion: (
+            jwt.decode(assertion, verify=False)["target_audience"],
+            expiry,
+            {},
+        )
+        credentials = service_account.IDTokenCredentials.from_service_account_file(
+            SERVICE_ACCOUNT_FILE, target_audience=ID_TOKEN_AUDIENCE
+        )
+        provider = id_token.IDTokenProvider(credentials)
+
+        for _ in range(3):
+            assert provider.get_token(mock.sentinel.request, "a") == "a"
+            assert provider.get_token(mock.sentinel.request, "b") == "b"
+
+        assert id_token_jwt_grant.call_count == 2
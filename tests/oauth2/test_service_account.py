@@ -218,7 +218,39 @@ class TestCredentials(object):
 
         audience = "https://pubsub.googleapis.com"
         credentials._create_self_signed_jwt(audience)
-        jwt.from_signing_credentials.assert_called_once_with(credentials, audience)
+        jwt.from_signing_credentials.assert_called_once_with(
+            credentials, audience, quota_project_id=None
+        )
+
+    @mock.patch("google.auth.jwt.Credentials", instance=True, autospec=True)
+    def test__create_self_signed_jwt_same_audience(self, jwt):
+        credentials = service_account.Credentials(
+            SIGNER, self.SERVICE_ACCOUNT_EMAIL, self.TOKEN_URI
+        )
+
+        audience = "https://pubsub.googleapis.com"
+        credentials._create_self_signed_jwt(audience)
+        credentials._create_self_signed_jwt(audience)
+        jwt.from_signing_credentials.assert_called_once_with(
+            credentials, audience, quota_project_id=None
+        )
+
+    @mock.patch("google.auth.jwt.Credentials", instance=True, autospec=True)
+    def test__create_self_signed_jwt_new_audience(self, jwt):
+        credentials = service_account.Credentials(
+            SIGNER, self.SERVICE_ACCOUNT_EMAIL, self.TOKEN_URI
+        )
+
+        credentials._create_self_signed_jwt("https://pubsub.googleapis.com")
+        credentials._create_self_signed_jwt("https://storage.googleapis.com")
+        assert jwt.from_signing_credentials.call_count == 2
+        jwt.from_signing_credentials.assert_called_with(
+            credentials, "https://storage.googleapis.com", quota_project_id=None
+        )
+
+        # Returning to the first audience reuses its JWT credentials.
+        credentials._create_self_signed_jwt("https://pubsub.googleapis.com")
+        assert jwt.from_signing_credentials.call_count == 2
 
     @mock.patch("google.auth.jwt.Credentials", instance=True, autospec=True)
     def test__create_self_signed_jwt_with_user_scopes(self, jwt):
@@ -244,7 +276,9 @@ class TestCredentials(object):
 
         audience = "https://pubsub.googleapis.com"
         credentials._create_self_signed_jwt(audience)
-        jwt.from_signing_credentials.assert_called_once_with(credentials, audience)
+        jwt.from_signing_credentials.assert_called_once_with(
+            credentials, audience, quota_project_id=None
+        )
 
     @mock.patch("google.auth.jwt.Credentials", instance=True, autospec=True)
     def test__create_self_signed_jwt_always_use_jwt_access_with_scopes(self, jwt):
@@ -259,7 +293,10 @@ class TestCredentials(object):
         audience = "https://pubsub.googleapis.com"
         credentials._create_self_signed_jwt(audience)
         jwt.from_signing_credentials.assert_called_once_with(
-            credentials, None, additional_claims={"scope": "bar foo"}
+            credentials,
+            None,
+            additional_claims={"scope": "bar foo"},
+            quota_project_id=None,
         )
 
     @mock.patch("google.auth.jwt.Credentials", instance=True, autospec=True)
@@ -276,7 +313,10 @@ class TestCredentials(object):
 
         credentials._create_self_signed_jwt(None)
         jwt.from_signing_credentials.assert_called_once_with(
-            credentials, None, additional_claims={"scope": "bar foo"}
+            credentials,
+            None,
+            additional_claims={"scope": "bar foo"},
+            quota_project_id=None,
         )
 
     @mock.patch("google.auth.jwt.Credentials", instance=True, autospec=True)
@@ -371,6 +411,24 @@ class TestCredentials(object):
         assert credentials.token == token
         assert credentials.expiry == expiry
 
+    def test_refresh_with_jwt_credentials_reused(self):
+        credentials = self.make_credentials()
+        audience = "https://pubsub.googleapis.com"
+        request = mock.create_autospec(transport.Request, instance=True)
+
+        credentials._create_self_signed_jwt(audience)
+        credentials.before_request(request, "GET", "http://example.com", {})
+        token = credentials.token
+
+        # Creating the self-signed JWT again for the same audience must not
+        # discard the JWT that was already minted.
+        credentials._create_self_signed_jwt(audience)
+        with mock.patch("google.auth.jwt.Credentials._make_jwt") as make_jwt:
+            credentials.before_request(request, "GET", "http://example.com", {})
+
+        make_jwt.assert_not_called()
+        assert credentials.token == token
+
     @mock.patch("google.oauth2._client.jwt_grant", autospec=True)
     @mock.patch("google.auth.jwt.Credentials.refresh", autospec=True)
     def test_refresh_jwt_not_used_for_domain_wide_delegation(
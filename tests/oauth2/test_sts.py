@@ -13,6 +13,7 @@
 # limitations under the License.
 
 import json
+import threading
 
 import mock
 import pytest  # type: ignore
@@ -393,3 +394,90 @@ class TestStsClient(object):
         assert excinfo.match(
             r"Error code invalid_request: Invalid subject token - https://tools.ietf.org/html/rfc6749"
         )
+
+    def make_exchanges(self, count):
+        return [
+            {
+                "grant_type": self.GRANT_TYPE,
+                "subject_token": "SUBJECT_TOKEN_{}".format(index),
+                "subject_token_type": self.SUBJECT_TOKEN_TYPE,
+                "audience": self.AUDIENCE,
+            }
+            for index in range(count)
+        ]
+
+    @staticmethod
+    def echo_request(url, method, headers, body):
+        """Responds with an access token derived from the subject token."""
+        subject_token = dict(urllib.parse.parse_qsl(body))[b"subject_token"]
+        response = mock.create_autospec(transport.Response, instance=True)
+        if subject_token == b"SUBJECT_TOKEN_1":
+            response.status = http_client.BAD_REQUEST
+            response.data = json.dumps(TestStsClient.ERROR_RESPONSE).encode("utf-8")
+        else:
+            response.status = http_client.OK
+            response.data = json.dumps(
+                {"access_token": subject_token.decode("utf-8").lower()}
+            ).encode("utf-8")
+        return response
+
+    def test_exchange_tokens(self):
+        client = self.make_client(self.CLIENT_AUTH_BASIC)
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = self.echo_request
+
+        results = client.exchange_tokens(request, self.make_exchanges(5))
+
+        assert request.call_count == 5
+        assert [result.ok for result in results] == [True, False, True, True, True]
+        assert results[0].response_data == {"access_token": "subject_token_0"}
+        assert results[4].response_data == {"access_token": "subject_token_4"}
+        assert results[1].response_data is None
+        assert isinstance(results[1].error, exceptions.OAuthError)
+        assert "ExchangeResult" in repr(results[1])
+        for _, kwargs in request.call_args_list:
+            assert kwargs["headers"]["Authorization"] == "Basic {}".format(
+                BASIC_AUTH_ENCODING
+            )
+
+    def test_exchange_tokens_empty(self):
+        request = mock.create_autospec(transport.Request)
+
+        assert self.make_client().exchange_tokens(request, []) == []
+        request.assert_not_called()
+
+    def test_exchange_tokens_invalid_max_concurrency(self):
+        request = mock.create_autospec(transport.Request)
+
+        with pytest.raises(ValueError, match="max_concurrency"):
+            self.make_client().exchange_tokens(
+                request, self.make_exchanges(2), max_concurrency=0
+            )
+        request.assert_not_called()
+
+    def test_exchange_tokens_max_concurrency(self):
+        lock = threading.Lock()
+        in_flight = [0]
+        max_in_flight = [0]
+        barrier = threading.Event()
+
+        def request(**kwargs):
+            with lock:
+                in_flight[0] += 1
+                max_in_flight[0] = max(max_in_flight[0], in_flight[0])
+                if in_flight[0] == 3:
+                    barrier.set()
+            # Wait until the maximum is reached, so that it must be observed.
+            barrier.wait(5)
+            try:
+                return self.echo_request(**kwargs)
+            finally:
+                with lock:
+                    in_flight[0] -= 1
+
+        results = self.make_client().exchange_tokens(
+            request, self.make_exchanges(10), max_concurrency=3
+        )
+
+        assert len(results) == 10
+        assert max_in_flight[0] == 3
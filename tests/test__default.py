@@ -14,6 +14,8 @@
 
 import json
 import os
+import threading
+import time
 
 import mock
 import pytest  # type: ignore
@@ -176,6 +178,13 @@ EXTERNAL_ACCOUNT_GET_PROJECT_ID_PATCH = mock.patch.object(
 )
 
 
+@pytest.fixture(autouse=True)
+def reset_environment_detection():
+    _default._reset_environment_detection()
+    yield
+    _default._reset_environment_detection()
+
+
 def test_load_credentials_from_missing_file():
     with pytest.raises(exceptions.DefaultCredentialsError) as excinfo:
         _default.load_credentials_from_file("")
@@ -801,7 +810,154 @@ def test__get_gce_credentials_no_compute_engine():
 )
 def test__get_gce_credentials_explicit_request(ping):
     _default._get_gce_credentials(mock.sentinel.request)
-    ping.assert_called_with(request=mock.sentinel.request)
+    ping.assert_called_with(
+        request=mock.sentinel.request, deadline=_default._METADATA_PING_DEADLINE
+    )
+
+
+@mock.patch("google.auth._default._METADATA_PING_DEADLINE", 0.5)
+def test__get_gce_credentials_ping_deadline():
+    def request(url, method, headers, timeout):
+        # An unreachable metadata server, which takes the whole timeout.
+        time.sleep(timeout)
+        raise exceptions.TransportError("unreachable")
+
+    start = time.time()
+    credentials, project_id = _default._get_gce_credentials(request)
+    elapsed = time.time() - start
+
+    assert credentials is None
+    assert project_id is None
+    # Without the overall deadline, the three attempts would each wait for
+    # the per-attempt timeout.
+    assert elapsed < 1.5
+
+
+@mock.patch(
+    "google.auth.compute_engine._metadata.ping", return_value=True, autospec=True
+)
+@mock.patch(
+    "google.auth.compute_engine._metadata.get_project_id",
+    return_value="example-project",
+    autospec=True,
+)
+def test__get_gce_credentials_memoized(get_project_id, ping, monkeypatch):
+    _default._get_gce_credentials()
+    credentials, project_id = _default._get_gce_credentials()
+
+    assert isinstance(credentials, compute_engine.Credentials)
+    assert project_id == "example-project"
+    assert ping.call_count == 1
+    assert get_project_id.call_count == 1
+
+    # A change to the environment invalidates the detection results.
+    monkeypatch.setenv(environment_vars.GCE_METADATA_HOST, "localhost:8080")
+    _default._get_gce_credentials()
+
+    assert ping.call_count == 2
+
+
+@mock.patch("google.auth._exponential_backoff._monotonic", autospec=True)
+@mock.patch(
+    "google.auth.compute_engine._metadata.ping", return_value=False, autospec=True
+)
+def test__get_gce_credentials_unavailable_expires(ping, monotonic):
+    monotonic.return_value = 0
+    _default._get_gce_credentials()
+    monotonic.return_value = _default._METADATA_UNAVAILABLE_TTL - 1
+    _default._get_gce_credentials()
+
+    assert ping.call_count == 1
+
+    monotonic.return_value = _default._METADATA_UNAVAILABLE_TTL
+    _default._get_gce_credentials()
+
+    assert ping.call_count == 2
+
+
+@mock.patch(
+    "google.auth._cloud_sdk.get_project_id",
+    return_value=mock.sentinel.project_id,
+    autospec=True,
+)
+@mock.patch("os.path.isfile", return_value=True, autospec=True)
+@LOAD_FILE_PATCH
+def test__get_gcloud_sdk_credentials_project_id_memoized(
+    load, unused_isfile, get_project_id
+):
+    load.return_value = MOCK_CREDENTIALS, None
+
+    _default._get_gcloud_sdk_credentials()
+    _default._get_gcloud_sdk_credentials()
+
+    assert get_project_id.call_count == 1
+
+
+@mock.patch(
+    "google.auth.compute_engine._metadata.get_project_id",
+    return_value="example-project",
+    autospec=True,
+)
+class TestEnvironmentDetection(object):
+    @mock.patch("google.auth.compute_engine._metadata.ping", autospec=True)
+    def test_concurrent_ping(self, ping, unused_get):
+        in_flight = threading.Event()
+        release = threading.Event()
+
+        def side_effect(request, deadline):
+            in_flight.set()
+            release.wait()
+            return True
+
+        ping.side_effect = side_effect
+        detection = _default._EnvironmentDetection(())
+        results = []
+        thread = threading.Thread(
+            target=lambda: results.append(detection.get_metadata_ping())
+        )
+        thread.start()
+        in_flight.wait()
+
+        # A ping running on another thread is waited for, not started again.
+        other = threading.Thread(
+            target=lambda: results.append(detection.get_metadata_ping())
+        )
+        other.start()
+        release.set()
+        thread.join()
+        other.join()
+
+        assert results[0] is results[1]
+        assert results[0].available
+        assert results[0].project_id == "example-project"
+        assert ping.call_count == 1
+
+    def test_unavailable_ping_reused(self, unused_get):
+        detection = _default._EnvironmentDetection(())
+        with mock.patch(
+            "google.auth.compute_engine._metadata.ping",
+            return_value=False,
+            autospec=True,
+        ) as ping:
+            detection.get_metadata_ping()
+            detection.get_metadata_ping()
+
+        assert ping.call_count == 1
+
+
+@mock.patch(
+    "google.auth._cloud_sdk.get_application_default_credentials_path",
+    return_value=AUTHORIZED_USER_FILE,
+    autospec=True,
+)
+def test_default_gcloud_credentials_no_metadata_ping(unused_get_adc_path):
+    with mock.patch(
+        "google.auth._default._get_gce_credentials", autospec=True
+    ) as get_gce_credentials:
+        for _ in range(3):
+            _default.default()
+
+    assert not get_gce_credentials.called
 
 
 @mock.patch(
@@ -0,0 +1,176 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import sys
+
+import pytest  # type: ignore
+
+from google.auth import _executable_daemon
+from google.auth import exceptions
+
+TIMEOUT = 5
+
+# Echoes each request along with its process ID and request count. Requests
+# with "exit" set make it exit, and requests with "hang" set go unanswered.
+ECHO_SCRIPT = """
+import json
+import os
+import sys
+
+count = 0
+for line in sys.stdin:
+    request = json.loads(line)
+    count += 1
+    if request.get("exit"):
+        sys.stderr.write("exiting\\n")
+        sys.exit(3)
+    if request.get("hang"):
+        continue
+    if request.get("garbage"):
+        print("not json", flush=True)
+        continue
+    request.update(pid=os.getpid(), count=count, env=os.environ.get("ECHO_ENV"))
+    print(json.dumps(request), flush=True)
+"""
+
+# Exits as soon as it starts.
+FAILING_SCRIPT = """
+import sys
+sys.stderr.write("cannot start\\n")
+sys.exit(2)
+"""
+
+
+def make_script(tmpdir, content):
+    path = tmpdir.join("helper.py")
+    path.write(content)
+    return [sys.executable, str(path)]
+
+
+@pytest.fixture
+def daemon(tmpdir):
+    env = dict(os.environ, ECHO_ENV="value")
+    daemon = _executable_daemon.ExecutableDaemon(
+        make_script(tmpdir, ECHO_SCRIPT), env
+    )
+    yield daemon
+    daemon.close()
+
+
+def test_request(daemon):
+    response = daemon.request({"key": "value"}, TIMEOUT)
+
+    assert response["key"] == "value"
+    assert response["env"] == "value"
+    assert response["count"] == 1
+
+
+def test_request_reuses_process(daemon):
+    first = daemon.request({}, TIMEOUT)
+    second = daemon.request({}, TIMEOUT)
+
+    assert second["pid"] == first["pid"]
+    assert second["count"] == 2
+
+
+def test_request_restarts_exited_process(daemon):
+    first = daemon.request({}, TIMEOUT)
+    daemon._process.kill()
+    daemon._process.wait()
+
+    second = daemon.request({}, TIMEOUT)
+
+    assert second["pid"] != first["pid"]
+    assert second["count"] == 1
+
+
+def test_request_process_exits_twice(daemon):
+    with pytest.raises(exceptions.RefreshError) as excinfo:
+        daemon.request({"exit": True}, TIMEOUT)
+
+    assert excinfo.match(r"return code 3. Error: exiting")
+    # The next request starts the executable again.
+    assert daemon.request({}, TIMEOUT)["count"] == 1
+
+
+def test_request_timeout(daemon):
+    first = daemon.request({}, TIMEOUT)
+
+    with pytest.raises(exceptions.RefreshError) as excinfo:
+        daemon.request({"hang": True}, 0.2)
+
+    assert excinfo.match(r"did not respond within 0.2 seconds")
+    assert daemon._process is None
+    assert daemon.request({}, TIMEOUT)["pid"] != first["pid"]
+
+
+def test_request_invalid_json(daemon):
+    with pytest.raises(exceptions.RefreshError) as excinfo:
+        daemon.request({"garbage": True}, TIMEOUT)
+
+    assert excinfo.match(r"invalid JSON: not json")
+    assert daemon._process is None
+
+
+def test_request_unable_to_start(tmpdir):
+    daemon = _executable_daemon.ExecutableDaemon(
+        [str(tmpdir.join("missing"))], os.environ
+    )
+
+    with pytest.raises(exceptions.RefreshError) as excinfo:
+        daemon.request({}, TIMEOUT)
+
+    assert excinfo.match(r"Unable to start executable")
+
+
+def test_request_process_fails_to_start(tmpdir):
+    daemon = _executable_daemon.ExecutableDaemon(
+        make_script(tmpdir, FAILING_SCRIPT), os.environ
+    )
+
+    with pytest.raises(exceptions.RefreshError) as excinfo:
+        daemon.request({}, TIMEOUT)
+
+    assert excinfo.match(r"return code 2. Error: cannot start")
+
+
+def test_close(daemon):
+    daemon.request({}, TIMEOUT)
+    process = daemon._process
+
+    daemon.close()
+
+    assert process.returncode == 0
+    assert daemon._process is None
+    # Closing again does nothing.
+    daemon.close()
+
+
+def test_get_daemon(tmpdir):
+    args = make_script(tmpdir, ECHO_SCRIPT)
+    env = {"GOOGLE_EXTERNAL_ACCOUNT_AUDIENCE": "audience", "OTHER": "1"}
+    daemon = _executable_daemon.get_daemon(args, env)
+    try:
+        assert _executable_daemon.get_daemon(list(args), dict(env)) is daemon
+        # Unrelated environment variables don't start another daemon.
+        other_env = dict(env, OTHER="2", NEW="3")
+        assert _executable_daemon.get_daemon(args, other_env) is daemon
+        assert len(_executable_daemon._daemons) == 1
+
+        other_audience = dict(env, GOOGLE_EXTERNAL_ACCOUNT_AUDIENCE="other")
+        assert _executable_daemon.get_daemon(args, other_audience) is not daemon
+    finally:
+        _executable_daemon._close_all()
+    assert _executable_daemon._daemons == {}
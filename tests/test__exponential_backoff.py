@@ -0,0 +1,132 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import email.utils
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import _exponential_backoff
+
+
+@pytest.fixture(autouse=True)
+def sleep():
+    with mock.patch("time.sleep", autospec=True) as sleep:
+        yield sleep
+
+
+@mock.patch("random.uniform", side_effect=lambda low, high: high, autospec=True)
+def test_backoff(uniform, sleep):
+    backoff = _exponential_backoff.ExponentialBackoff(
+        total_attempts=5, initial_delay=1, max_delay=3, multiplier=2
+    )
+
+    assert list(backoff) == [1, 2, 3, 4, 5]
+    assert backoff.attempt == 5
+    assert uniform.call_args_list == [
+        mock.call(0, 1),
+        mock.call(0, 2),
+        mock.call(0, 3),
+        mock.call(0, 3),
+    ]
+    assert sleep.call_args_list == [
+        mock.call(1),
+        mock.call(2),
+        mock.call(3),
+        mock.call(3),
+    ]
+
+
+def test_backoff_restarts(sleep):
+    backoff = _exponential_backoff.ExponentialBackoff(total_attempts=2)
+
+    assert list(backoff) == [1, 2]
+    assert list(backoff) == [1, 2]
+    assert sleep.call_count == 2
+
+
+@mock.patch("random.uniform", return_value=0.5, autospec=True)
+def test_retry_after(unused_uniform, sleep):
+    backoff = _exponential_backoff.ExponentialBackoff(total_attempts=3)
+    attempts = iter(backoff)
+
+    next(attempts)
+    backoff.retry_after(10)
+    next(attempts)
+    next(attempts)
+
+    # Retry-After only applies to the next delay.
+    assert sleep.call_args_list == [mock.call(10), mock.call(0.5)]
+
+
+@mock.patch("random.uniform", return_value=0.5, autospec=True)
+def test_retry_after_capped(unused_uniform, sleep):
+    backoff = _exponential_backoff.ExponentialBackoff(total_attempts=2, max_delay=30)
+    attempts = iter(backoff)
+
+    next(attempts)
+    backoff.retry_after(3600)
+    next(attempts)
+
+    assert sleep.call_args_list == [mock.call(30)]
+
+
+@mock.patch("random.uniform", return_value=0.5, autospec=True)
+@mock.patch("google.auth._exponential_backoff._monotonic", autospec=True)
+def test_deadline(time, unused_uniform, sleep):
+    time.return_value = 0
+    backoff = _exponential_backoff.ExponentialBackoff(
+        total_attempts=10, initial_delay=1, deadline=5
+    )
+
+    attempts = 0
+    for _ in backoff:
+        attempts += 1
+        assert backoff.remaining() == 5 - time.return_value
+        time.return_value += 2
+
+    assert attempts == 3
+    assert backoff.remaining() == 0
+
+
+def test_no_deadline():
+    backoff = iter(_exponential_backoff.ExponentialBackoff())
+
+    assert backoff.remaining() is None
+
+
+def test_span(sleep):
+    backoff = _exponential_backoff.ExponentialBackoff(
+        total_attempts=2, span_name="name"
+    )
+
+    with mock.patch("google.auth.instrumentation._span", autospec=True) as span:
+        list(backoff)
+
+    span.assert_called_once_with("name", attempt="2")
+
+
+@pytest.mark.parametrize(
+    "value, expected",
+    [(None, None), ("", None), ("invalid", None), ("3", 3.0), ("-1", 0.0)],
+)
+def test_parse_retry_after(value, expected):
+    assert _exponential_backoff.parse_retry_after(value) == expected
+
+
+@mock.patch("time.time", return_value=1000, autospec=True)
+def test_parse_retry_after_date(unused_time):
+    value = email.utils.formatdate(1030, usegmt=True)
+
+    assert _exponential_backoff.parse_retry_after(value) == 30
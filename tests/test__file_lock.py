@@ -0,0 +1,112 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import subprocess
+import sys
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import _file_lock
+
+# Holds the lock until its standard input closes.
+HOLD_SCRIPT = """
+import sys
+from google.auth import _file_lock
+
+lock = _file_lock.FileLock(sys.argv[1])
+assert lock.acquire(5)
+print("locked", flush=True)
+sys.stdin.read()
+"""
+
+
+@pytest.fixture
+def lock_path(tmpdir):
+    return str(tmpdir.join("file.lock"))
+
+
+def test_acquire_release(lock_path):
+    lock = _file_lock.FileLock(lock_path)
+
+    assert lock.acquire(0)
+    assert os.path.exists(lock_path)
+    lock.release()
+    assert lock.acquire(0)
+    lock.release()
+    # Releasing again does nothing.
+    lock.release()
+
+
+def test_acquire_held_by_other_lock(lock_path):
+    holder = _file_lock.FileLock(lock_path)
+    waiter = _file_lock.FileLock(lock_path)
+    assert holder.acquire(0)
+
+    assert not waiter.acquire(0.1)
+
+    holder.release()
+    assert waiter.acquire(0)
+    waiter.release()
+
+
+def test_acquire_held_by_other_process(lock_path):
+    process = subprocess.Popen(
+        [sys.executable, "-c", HOLD_SCRIPT, lock_path],
+        stdin=subprocess.PIPE,
+        stdout=subprocess.PIPE,
+        universal_newlines=True,
+    )
+    try:
+        assert process.stdout.readline() == "locked\n"
+        lock = _file_lock.FileLock(lock_path)
+
+        assert not lock.acquire(0.1)
+    finally:
+        process.stdin.close()
+        process.wait()
+
+    # The lock is released when the process exits.
+    assert lock.acquire(1)
+    lock.release()
+
+
+def test_acquire_unable_to_open(tmpdir):
+    lock = _file_lock.FileLock(str(tmpdir.join("missing", "file.lock")))
+
+    with pytest.raises(OSError):
+        lock.acquire(0)
+
+
+def test_write_atomically(tmpdir):
+    path = tmpdir.join("file")
+    path.write("old")
+
+    _file_lock.write_atomically(str(path), u"new")
+
+    assert path.read() == "new"
+    assert tmpdir.listdir() == [path]
+
+
+def test_write_atomically_failure(tmpdir):
+    path = tmpdir.join("file")
+    path.write("old")
+
+    with mock.patch("os.replace", side_effect=OSError()):
+        with pytest.raises(OSError):
+            _file_lock.write_atomically(str(path), u"new")
+
+    assert path.read() == "old"
+    assert tmpdir.listdir() == [path]
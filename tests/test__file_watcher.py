@@ -0,0 +1,235 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import io
+import os
+import shutil
+import sys
+
+import mock
+import pytest  # type: ignore
+from six.moves import queue
+
+from google.auth import _file_watcher
+
+TIMEOUT = 5
+
+requires_inotify = pytest.mark.skipif(
+    not sys.platform.startswith("linux"), reason="inotify is only on Linux"
+)
+
+
+def write(path, content):
+    with io.open(str(path), "w", encoding="utf-8") as file_obj:
+        file_obj.write(content)
+
+
+@pytest.fixture
+def token_file(tmpdir):
+    path = tmpdir.join("token")
+    write(path, u"token-1")
+    return str(path)
+
+
+@pytest.fixture
+def watcher(token_file):
+    watcher = _file_watcher.FileWatcher(token_file, poll_interval=0.05)
+    yield watcher
+    watcher.close()
+
+
+def subscribe(watcher):
+    changes = queue.Queue()
+    watcher.subscribe(changes.put)
+    return changes
+
+
+def wait_until_current(watcher):
+    for _ in range(500):
+        if watcher._current:
+            return
+        _file_watcher.threading.Event().wait(0.01)
+    pytest.fail("The watcher never relied on inotify")
+
+
+def test_read(watcher, token_file):
+    with mock.patch("io.open", wraps=io.open) as open_:
+        assert watcher.read() == u"token-1"
+        assert watcher.read() == u"token-1"
+
+    assert open_.call_count == 1
+
+    write(token_file, u"token-two")
+
+    assert watcher.read() == u"token-two"
+
+
+def test_read_missing_file(tmpdir):
+    watcher = _file_watcher.FileWatcher(str(tmpdir.join("missing")))
+
+    with pytest.raises((IOError, OSError)):
+        watcher.read()
+
+
+def test_read_replaced_file(watcher, token_file, tmpdir):
+    assert watcher.read() == u"token-1"
+    new_file = tmpdir.join("new")
+    write(new_file, u"token-2")
+
+    os.rename(str(new_file), token_file)
+
+    assert watcher.read() == u"token-2"
+
+
+@mock.patch.object(_file_watcher._Inotify, "create", return_value=None)
+def test_subscribe_polling(create, watcher, token_file):
+    changes = subscribe(watcher)
+
+    write(token_file, u"token-two")
+
+    assert changes.get(timeout=TIMEOUT) == u"token-two"
+    assert not watcher._current
+    assert watcher.read() == u"token-two"
+
+
+@requires_inotify
+def test_subscribe_inotify(watcher, token_file):
+    changes = subscribe(watcher)
+    wait_until_current(watcher)
+
+    # Reads don't check the file while inotify reports the changes.
+    with mock.patch("os.stat") as stat:
+        assert watcher.read() == u"token-1"
+    stat.assert_not_called()
+
+    write(token_file, u"token-two")
+
+    assert changes.get(timeout=TIMEOUT) == u"token-two"
+    assert watcher.read() == u"token-two"
+
+
+@requires_inotify
+def test_subscribe_inotify_symlink_swap(tmpdir):
+    # The layout of Kubernetes projected volumes: token -> ..data/token, and
+    # ..data is a symlink to a timestamped directory that is swapped.
+    first = tmpdir.mkdir("..2022_01")
+    write(first.join("token"), u"token-1")
+    os.symlink("..2022_01", str(tmpdir.join("..data")))
+    os.symlink(os.path.join("..data", "token"), str(tmpdir.join("token")))
+    watcher = _file_watcher.FileWatcher(str(tmpdir.join("token")))
+    changes = subscribe(watcher)
+
+    try:
+        wait_until_current(watcher)
+        second = tmpdir.mkdir("..2022_02")
+        write(second.join("token"), u"token-2")
+        os.symlink("..2022_02", str(tmpdir.join("..data_tmp")))
+        os.rename(str(tmpdir.join("..data_tmp")), str(tmpdir.join("..data")))
+
+        assert changes.get(timeout=TIMEOUT) == u"token-2"
+        assert watcher.read() == u"token-2"
+    finally:
+        watcher.close()
+
+
+@requires_inotify
+def test_subscribe_inotify_rewatch_after_rotation(tmpdir):
+    # Kubernetes removes the previous timestamped directory after the swap,
+    # which ends its watch; later rotations are still reported by inotify.
+    os.symlink("..2022_01", str(tmpdir.join("..data")))
+    os.symlink(os.path.join("..data", "token"), str(tmpdir.join("token")))
+    write(tmpdir.mkdir("..2022_01").join("token"), u"token-1")
+    watcher = _file_watcher.FileWatcher(str(tmpdir.join("token")))
+    changes = subscribe(watcher)
+
+    def rotate(old, new, content):
+        write(tmpdir.mkdir(new).join("token"), content)
+        os.symlink(new, str(tmpdir.join("..data_tmp")))
+        os.rename(str(tmpdir.join("..data_tmp")), str(tmpdir.join("..data")))
+        shutil.rmtree(str(tmpdir.join(old)))
+
+    try:
+        wait_until_current(watcher)
+        rotate("..2022_01", "..2022_02", u"token-2")
+        assert changes.get(timeout=TIMEOUT) == u"token-2"
+
+        rotate("..2022_02", "..2022_03", u"token-3")
+        assert changes.get(timeout=TIMEOUT) == u"token-3"
+        wait_until_current(watcher)
+        assert watcher.read() == u"token-3"
+    finally:
+        watcher.close()
+
+
+@mock.patch.object(_file_watcher._Inotify, "create", autospec=True)
+def test_subscribe_inotify_rewatch_unavailable(create, watcher, token_file):
+    # The watch can't be set up again at first, so the file is polled until
+    # it can.
+    inotify = mock.Mock(fd=os.open(os.devnull, os.O_RDONLY), spec=["fd", "close"])
+    inotify.read_events = mock.Mock(return_value=False)
+    watches = [inotify]
+    create.side_effect = lambda directories: watches.pop() if watches else None
+    changes = subscribe(watcher)
+
+    try:
+        for _ in range(500):
+            if create.call_count >= 3:
+                break
+            _file_watcher.threading.Event().wait(0.01)
+        assert create.call_count >= 3
+        write(token_file, u"token-two")
+        assert changes.get(timeout=TIMEOUT) == u"token-two"
+    finally:
+        watcher.close()
+        os.close(inotify.fd)
+
+
+def test_subscribe_callback_error(watcher, token_file):
+    changes = queue.Queue()
+    watcher.subscribe(mock.Mock(side_effect=ValueError()))
+    watcher.subscribe(changes.put)
+
+    write(token_file, u"token-two")
+
+    assert changes.get(timeout=TIMEOUT) == u"token-two"
+
+
+def test_unsubscribe(watcher, token_file):
+    callback = mock.Mock()
+    changes = subscribe(watcher)
+    watcher.subscribe(callback)
+    watcher.unsubscribe(callback)
+    watcher.unsubscribe(callback)
+
+    write(token_file, u"token-two")
+
+    assert changes.get(timeout=TIMEOUT) == u"token-two"
+    callback.assert_not_called()
+
+
+@mock.patch("sys.platform", "win32")
+def test_inotify_unavailable():
+    assert _file_watcher._Inotify.create(["."]) is None
+
+
+@requires_inotify
+def test_inotify_missing_directory(tmpdir):
+    assert _file_watcher._Inotify.create([str(tmpdir.join("missing"))]) is None
+
+
+def test_get_watcher(token_file):
+    watcher = _file_watcher.get_watcher(token_file)
+
+    assert watcher.path == token_file
+    assert _file_watcher.get_watcher(token_file) is watcher
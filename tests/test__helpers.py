@@ -168,3 +168,40 @@ def test_unpadded_urlsafe_b64encode():
 
     for case, expected in cases:
         assert _helpers.unpadded_urlsafe_b64encode(case) == expected
+
+
+def test_map_concurrently():
+    results = _helpers.map_concurrently(lambda item: item * 2, range(25), 4, "test")
+
+    assert results == [item * 2 for item in range(25)]
+
+
+def test_map_concurrently_first_serially():
+    calls = []
+
+    def func(item):
+        calls.append(item)
+        return item
+
+    assert _helpers.map_concurrently(func, [1, 2, 3], 2, "test", True) == [1, 2, 3]
+    assert calls[0] == 1
+
+
+def test_map_concurrently_empty():
+    assert _helpers.map_concurrently(None, [], 1, "test", True) == []
+
+
+def test_map_concurrently_error():
+    def func(item):
+        if item == 3:
+            raise ValueError("bad item")
+        return item
+
+    with pytest.raises(ValueError, match="bad item"):
+        _helpers.map_concurrently(func, range(10), 2, "test")
+
+
+@pytest.mark.parametrize("max_concurrency", [0, -1])
+def test_map_concurrently_invalid_max_concurrency(max_concurrency):
+    with pytest.raises(ValueError, match="max_concurrency"):
+        _helpers.map_concurrently(None, [1], max_concurrency, "test")
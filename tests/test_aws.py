@@ -570,6 +570,79 @@ class TestRequestSigner(object):
 
         assert excinfo.match(r"Invalid AWS service URL")
 
+    @pytest.mark.parametrize(
+        "region, time, credentials, original_request, signed_request", TEST_FIXTURES
+    )
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_get_request_options_reused_signer(
+        self, utcnow, region, time, credentials, original_request, signed_request
+    ):
+        utcnow.return_value = datetime.datetime.strptime(time, "%Y-%m-%dT%H:%M:%SZ")
+        request_signer = aws.RequestSigner(region)
+
+        for _ in range(2):
+            actual_signed_request = request_signer.get_request_options(
+                credentials,
+                original_request.get("url"),
+                original_request.get("method"),
+                original_request.get("data"),
+                original_request.get("headers"),
+            )
+
+            assert actual_signed_request == signed_request
+
+    @mock.patch("google.auth._helpers.utcnow")
+    @mock.patch("google.auth.aws._get_signing_key", wraps=aws._get_signing_key)
+    def test_get_request_options_caches_signing_key(self, get_signing_key, utcnow):
+        utcnow.return_value = datetime.datetime(2020, 8, 11, 6, 55, 22)
+        request_signer = aws.RequestSigner("us-east-2")
+        credentials = {
+            "access_key_id": ACCESS_KEY_ID,
+            "secret_access_key": SECRET_ACCESS_KEY,
+        }
+        url = "https://sts.us-east-2.amazonaws.com?Action=GetCallerIdentity"
+
+        request_signer.get_request_options(credentials, url, "POST")
+        utcnow.return_value += datetime.timedelta(hours=1)
+        request_signer.get_request_options(credentials, url, "POST")
+
+        get_signing_key.assert_called_once_with(
+            SECRET_ACCESS_KEY, "20200811", "us-east-2", "sts"
+        )
+
+        # Another secret, service or date needs another key.
+        request_signer.get_request_options(
+            dict(credentials, secret_access_key="other"), url, "POST"
+        )
+        request_signer.get_request_options(
+            credentials, "https://iam.amazonaws.com/", "POST"
+        )
+        utcnow.return_value += datetime.timedelta(days=1)
+        request_signer.get_request_options(credentials, url, "POST")
+
+        assert get_signing_key.call_args_list[1:] == [
+            mock.call("other", "20200811", "us-east-2", "sts"),
+            mock.call(SECRET_ACCESS_KEY, "20200811", "us-east-2", "iam"),
+            mock.call(SECRET_ACCESS_KEY, "20200812", "us-east-2", "sts"),
+        ]
+        assert list(request_signer._signing_keys._keys) == [
+            (SECRET_ACCESS_KEY, "20200812", "us-east-2", "sts")
+        ]
+
+    def test_get_request_options_url_cache_bounded(self):
+        request_signer = aws.RequestSigner("us-east-2")
+        credentials = {
+            "access_key_id": ACCESS_KEY_ID,
+            "secret_access_key": SECRET_ACCESS_KEY,
+        }
+
+        for index in range(aws._MAX_CACHED_URLS + 1):
+            request_signer.get_request_options(
+                credentials, "https://sts.amazonaws.com/{}".format(index), "POST"
+            )
+
+        assert len(request_signer._url_components) == 1
+
 
 class TestCredentials(object):
     AWS_REGION = "us-east-2"
@@ -1000,25 +1073,20 @@ class TestCredentials(object):
             {"Content-Type": "application/json"},
         )
 
-        # Retrieve subject_token again. Region should not be queried again.
+        # Retrieve subject_token again. Region and role should not be queried
+        # again.
         new_request = self.make_mock_request(
-            role_status=http_client.OK,
-            role_name=self.AWS_ROLE,
             security_credentials_status=http_client.OK,
             security_credentials_data=self.AWS_SECURITY_CREDENTIALS_RESPONSE,
         )
 
         credentials.retrieve_subject_token(new_request)
 
-        # Only 3 requests should be sent as the region is cached.
-        assert len(new_request.call_args_list) == 2
-        # Assert role request.
-        self.assert_aws_metadata_request_kwargs(
-            new_request.call_args_list[0][1], SECURITY_CREDS_URL
-        )
+        # Only 1 request should be sent as the region and role are cached.
+        assert len(new_request.call_args_list) == 1
         # Assert security credentials request.
         self.assert_aws_metadata_request_kwargs(
-            new_request.call_args_list[1][1],
+            new_request.call_args_list[0][1],
             "{}/{}".format(SECURITY_CREDS_URL, self.AWS_ROLE),
             {"Content-Type": "application/json"},
         )
@@ -1086,36 +1154,20 @@ class TestCredentials(object):
             },
         )
 
-        # Retrieve subject_token again. Region should not be queried again.
+        # Retrieve subject_token again. The session token, region and role
+        # should not be queried again.
         new_request = self.make_mock_request(
-            role_status=http_client.OK,
-            role_name=self.AWS_ROLE,
             security_credentials_status=http_client.OK,
             security_credentials_data=self.AWS_SECURITY_CREDENTIALS_RESPONSE,
-            imdsv2_session_token_status=http_client.OK,
-            imdsv2_session_token_data=self.AWS_IMDSV2_SESSION_TOKEN,
         )
 
         credentials.retrieve_subject_token(new_request)
 
-        # Only 3 requests should be sent as the region is cached.
-        assert len(new_request.call_args_list) == 3
-        # Assert session token request
-        self.assert_aws_metadata_request_kwargs(
-            request.call_args_list[0][1],
-            IMDSV2_SESSION_TOKEN_URL,
-            {"X-aws-ec2-metadata-token-ttl-seconds": "300"},
-            "PUT",
-        )
-        # Assert role request.
-        self.assert_aws_metadata_request_kwargs(
-            new_request.call_args_list[1][1],
-            SECURITY_CREDS_URL,
-            {"X-aws-ec2-metadata-token": self.AWS_IMDSV2_SESSION_TOKEN},
-        )
+        # Only 1 request should be sent as the rest is cached.
+        assert len(new_request.call_args_list) == 1
         # Assert security credentials request.
         self.assert_aws_metadata_request_kwargs(
-            new_request.call_args_list[2][1],
+            new_request.call_args_list[0][1],
             "{}/{}".format(SECURITY_CREDS_URL, self.AWS_ROLE),
             {
                 "Content-Type": "application/json",
@@ -1123,6 +1175,29 @@ class TestCredentials(object):
             },
         )
 
+        # The session token is requested again once it is about to expire.
+        utcnow.return_value += datetime.timedelta(seconds=280)
+        new_request = self.make_mock_request(
+            security_credentials_status=http_client.OK,
+            security_credentials_data=self.AWS_SECURITY_CREDENTIALS_RESPONSE,
+            imdsv2_session_token_status=http_client.OK,
+            imdsv2_session_token_data="newsessiontoken",
+        )
+
+        credentials.retrieve_subject_token(new_request)
+
+        assert len(new_request.call_args_list) == 2
+        self.assert_aws_metadata_request_kwargs(
+            new_request.call_args_list[0][1],
+            IMDSV2_SESSION_TOKEN_URL,
+            {"X-aws-ec2-metadata-token-ttl-seconds": "300"},
+            "PUT",
+        )
+        assert new_request.call_args_list[1][1]["headers"] == {
+            "Content-Type": "application/json",
+            "X-aws-ec2-metadata-token": "newsessiontoken",
+        }
+
     @mock.patch("google.auth._helpers.utcnow")
     def test_retrieve_subject_token_session_error_idmsv2(self, utcnow):
         utcnow.return_value = datetime.datetime.strptime(
@@ -1295,6 +1370,191 @@ class TestCredentials(object):
             }
         )
 
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_retrieve_subject_token_caches_security_credentials(self, utcnow):
+        utcnow.return_value = datetime.datetime.strptime(
+            self.AWS_SIGNATURE_TIME, "%Y-%m-%dT%H:%M:%SZ"
+        )
+        security_credentials_response = dict(
+            self.AWS_SECURITY_CREDENTIALS_RESPONSE, Expiration="2020-08-11T07:55:22Z"
+        )
+        request = self.make_mock_request(
+            region_status=http_client.OK,
+            region_name=self.AWS_REGION,
+            role_status=http_client.OK,
+            role_name=self.AWS_ROLE,
+            security_credentials_status=http_client.OK,
+            security_credentials_data=security_credentials_response,
+            imdsv2_session_token_status=http_client.OK,
+            imdsv2_session_token_data=self.AWS_IMDSV2_SESSION_TOKEN,
+        )
+        credential_source = dict(
+            self.CREDENTIAL_SOURCE, imdsv2_session_token_url=IMDSV2_SESSION_TOKEN_URL
+        )
+        credentials = self.make_credentials(credential_source=credential_source)
+        expected_subject_token = self.make_serialized_aws_signed_request(
+            {
+                "access_key_id": ACCESS_KEY_ID,
+                "secret_access_key": SECRET_ACCESS_KEY,
+                "security_token": TOKEN,
+            }
+        )
+
+        assert credentials.retrieve_subject_token(request) == expected_subject_token
+        assert len(request.call_args_list) == 4
+
+        # Until shortly before their expiration, the credentials are reused
+        # without calling the metadata server at all.
+        utcnow.return_value += datetime.timedelta(minutes=50)
+        new_request = self.make_mock_request()
+
+        subject_token = credentials.retrieve_subject_token(new_request)
+
+        assert subject_token == self.make_serialized_aws_signed_request(
+            {
+                "access_key_id": ACCESS_KEY_ID,
+                "secret_access_key": SECRET_ACCESS_KEY,
+                "security_token": TOKEN,
+            }
+        )
+        new_request.assert_not_called()
+
+        # They are then retrieved ahead of their expiration.
+        utcnow.return_value += datetime.timedelta(minutes=6)
+        new_request = self.make_mock_request(
+            security_credentials_status=http_client.OK,
+            security_credentials_data=dict(
+                security_credentials_response, Token="new-token"
+            ),
+            imdsv2_session_token_status=http_client.OK,
+            imdsv2_session_token_data=self.AWS_IMDSV2_SESSION_TOKEN,
+        )
+
+        subject_token = credentials.retrieve_subject_token(new_request)
+
+        assert len(new_request.call_args_list) == 2
+        assert subject_token == self.make_serialized_aws_signed_request(
+            {
+                "access_key_id": ACCESS_KEY_ID,
+                "secret_access_key": SECRET_ACCESS_KEY,
+                "security_token": "new-token",
+            }
+        )
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_retrieve_subject_token_refresh_ahead_failure(self, utcnow):
+        utcnow.return_value = datetime.datetime.strptime(
+            self.AWS_SIGNATURE_TIME, "%Y-%m-%dT%H:%M:%SZ"
+        )
+        security_credentials_response = dict(
+            self.AWS_SECURITY_CREDENTIALS_RESPONSE, Expiration="2020-08-11T07:55:22Z"
+        )
+        request = self.make_mock_request(
+            region_status=http_client.OK,
+            region_name=self.AWS_REGION,
+            role_status=http_client.OK,
+            role_name=self.AWS_ROLE,
+            security_credentials_status=http_client.OK,
+            security_credentials_data=security_credentials_response,
+        )
+        credentials = self.make_credentials(credential_source=self.CREDENTIAL_SOURCE)
+        credentials.retrieve_subject_token(request)
+
+        # The cached credentials are used while they haven't expired.
+        utcnow.return_value += datetime.timedelta(minutes=58)
+        new_request = self.make_mock_request(
+            security_credentials_status=http_client.NOT_FOUND
+        )
+
+        subject_token = credentials.retrieve_subject_token(new_request)
+
+        assert subject_token == self.make_serialized_aws_signed_request(
+            {
+                "access_key_id": ACCESS_KEY_ID,
+                "secret_access_key": SECRET_ACCESS_KEY,
+                "security_token": TOKEN,
+            }
+        )
+
+        # The role name is retrieved again after a failure.
+        utcnow.return_value += datetime.timedelta(minutes=2)
+        new_request = self.make_mock_request(
+            role_status=http_client.OK,
+            role_name="new-role",
+            security_credentials_status=http_client.NOT_FOUND,
+        )
+
+        with pytest.raises(exceptions.RefreshError) as excinfo:
+            credentials.retrieve_subject_token(new_request)
+
+        assert excinfo.match(r"Unable to retrieve AWS security credentials")
+        self.assert_aws_metadata_request_kwargs(
+            new_request.call_args_list[1][1],
+            "{}/{}".format(SECURITY_CREDS_URL, "new-role"),
+            {"Content-Type": "application/json"},
+        )
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_retrieve_subject_token_session_token_cleared_on_error(self, utcnow):
+        utcnow.return_value = datetime.datetime.strptime(
+            self.AWS_SIGNATURE_TIME, "%Y-%m-%dT%H:%M:%SZ"
+        )
+        request = self.make_mock_request(
+            region_status=http_client.UNAUTHORIZED,
+            imdsv2_session_token_status=http_client.OK,
+            imdsv2_session_token_data=self.AWS_IMDSV2_SESSION_TOKEN,
+        )
+        credential_source = dict(
+            self.CREDENTIAL_SOURCE, imdsv2_session_token_url=IMDSV2_SESSION_TOKEN_URL
+        )
+        credentials = self.make_credentials(credential_source=credential_source)
+
+        with pytest.raises(exceptions.RefreshError):
+            credentials.retrieve_subject_token(request)
+
+        new_request = self.make_mock_request(
+            imdsv2_session_token_status=http_client.OK,
+            imdsv2_session_token_data=self.AWS_IMDSV2_SESSION_TOKEN,
+            region_status=http_client.OK,
+            region_name=self.AWS_REGION,
+            role_status=http_client.OK,
+            role_name=self.AWS_ROLE,
+            security_credentials_status=http_client.OK,
+            security_credentials_data=self.AWS_SECURITY_CREDENTIALS_RESPONSE,
+        )
+
+        credentials.retrieve_subject_token(new_request)
+
+        self.assert_aws_metadata_request_kwargs(
+            new_request.call_args_list[0][1],
+            IMDSV2_SESSION_TOKEN_URL,
+            {"X-aws-ec2-metadata-token-ttl-seconds": "300"},
+            "PUT",
+        )
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_retrieve_subject_token_environment_vars_skip_session_token(
+        self, utcnow, monkeypatch
+    ):
+        monkeypatch.setenv(environment_vars.AWS_ACCESS_KEY_ID, ACCESS_KEY_ID)
+        monkeypatch.setenv(environment_vars.AWS_SECRET_ACCESS_KEY, SECRET_ACCESS_KEY)
+        monkeypatch.setenv(environment_vars.AWS_REGION, self.AWS_REGION)
+        utcnow.return_value = datetime.datetime.strptime(
+            self.AWS_SIGNATURE_TIME, "%Y-%m-%dT%H:%M:%SZ"
+        )
+        credential_source = dict(
+            self.CREDENTIAL_SOURCE, imdsv2_session_token_url=IMDSV2_SESSION_TOKEN_URL
+        )
+        credentials = self.make_credentials(credential_source=credential_source)
+        request = self.make_mock_request()
+
+        subject_token = credentials.retrieve_subject_token(request)
+
+        assert subject_token == self.make_serialized_aws_signed_request(
+            {"access_key_id": ACCESS_KEY_ID, "secret_access_key": SECRET_ACCESS_KEY}
+        )
+        request.assert_not_called()
+
     def test_retrieve_subject_token_error_determining_aws_region(self):
         # Simulate error in retrieving the AWS region.
         request = self.make_mock_request(region_status=http_client.BAD_REQUEST)
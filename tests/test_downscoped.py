@@ -14,6 +14,7 @@
 
 import datetime
 import json
+import threading
 
 import mock
 import pytest  # type: ignore
@@ -94,7 +95,8 @@ class SourceCredentials(credentials.Credentials):
         now = _helpers.utcnow()
         self._counter += 1
         self.token = "ACCESS_TOKEN_{}".format(self._counter)
-        self.expiry = now + datetime.timedelta(seconds=self._expires_in)
+        if self._expires_in is not None:
+            self.expiry = now + datetime.timedelta(seconds=self._expires_in)
 
 
 def make_availability_condition(expression, title=None, description=None):
@@ -581,6 +583,35 @@ class TestCredentials(object):
             # Confirm source credentials called with the same request instance.
             wrapped_souce_cred_refresh.assert_called_with(request)
 
+    def test_refresh_source_credentials_valid(self):
+        request = self.make_mock_request(status=http_client.OK, data=SUCCESS_RESPONSE)
+        source_credentials = SourceCredentials()
+        source_credentials.refresh(None)
+        credentials = self.make_credentials(source_credentials=source_credentials)
+
+        credentials.refresh(request)
+        credentials.refresh(request)
+
+        # The source token is still valid, so it is exchanged without a refresh.
+        assert source_credentials._counter == 1
+        assert request.call_count == 2
+        body = dict(urllib.parse.parse_qsl(request.call_args[1]["body"]))
+        assert body[b"subject_token"] == b"ACCESS_TOKEN_1"
+
+    def test_refresh_source_credentials_without_expiry(self):
+        request = self.make_mock_request(status=http_client.OK, data=SUCCESS_RESPONSE)
+        source_credentials = SourceCredentials(expires_in=None)
+        source_credentials.refresh(None)
+        credentials = self.make_credentials(source_credentials=source_credentials)
+
+        credentials.refresh(request)
+        credentials.refresh(request)
+
+        # A token without an expiry may have been revoked, so it isn't reused.
+        assert source_credentials._counter == 3
+        body = dict(urllib.parse.parse_qsl(request.call_args[1]["body"]))
+        assert body[b"subject_token"] == b"ACCESS_TOKEN_3"
+
     def test_refresh_token_exchange_error(self):
         request = self.make_mock_request(
             status=http_client.BAD_REQUEST, data=ERROR_RESPONSE
@@ -694,3 +725,145 @@ class TestCredentials(object):
         assert headers == {
             "authorization": "Bearer {}".format(SUCCESS_RESPONSE["access_token"])
         }
+
+
+class TestCredentialsPool(object):
+    @staticmethod
+    def make_boundary(available_resource=AVAILABLE_RESOURCE):
+        availability_condition = make_availability_condition(
+            EXPRESSION, TITLE, DESCRIPTION
+        )
+        return make_credential_access_boundary(
+            [
+                make_access_boundary_rule(
+                    available_resource, AVAILABLE_PERMISSIONS, availability_condition
+                )
+            ]
+        )
+
+    @staticmethod
+    def make_mock_request(*access_tokens):
+        responses = []
+        for access_token in access_tokens:
+            response = mock.create_autospec(transport.Response, instance=True)
+            response.status = http_client.OK
+            response.data = json.dumps(
+                dict(SUCCESS_RESPONSE, access_token=access_token)
+            ).encode("utf-8")
+            responses.append(response)
+
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = responses
+        return request
+
+    def test_get_credentials(self):
+        source_credentials = SourceCredentials()
+        pool = downscoped.CredentialsPool(
+            source_credentials, quota_project_id=QUOTA_PROJECT_ID
+        )
+
+        credentials = pool.get_credentials(self.make_boundary())
+
+        assert isinstance(credentials, downscoped.Credentials)
+        assert credentials._source_credentials is source_credentials
+        assert credentials.quota_project_id == QUOTA_PROJECT_ID
+        # Equal boundaries share the credentials.
+        assert pool.get_credentials(self.make_boundary()) is credentials
+        assert (
+            pool.get_credentials(self.make_boundary(OTHER_AVAILABLE_RESOURCE))
+            is not credentials
+        )
+
+    def test_get_token_cached(self):
+        request = self.make_mock_request("TOKEN")
+        pool = downscoped.CredentialsPool(SourceCredentials())
+
+        token, expiry = pool.get_token(request, self.make_boundary())
+
+        assert token == "TOKEN"
+        assert expiry is not None
+        assert pool.get_token(request, self.make_boundary()) == (token, expiry)
+        assert request.call_count == 1
+
+    def test_get_token_shares_source_credentials(self):
+        request = self.make_mock_request("TOKEN", "OTHER_TOKEN")
+        source_credentials = SourceCredentials()
+        pool = downscoped.CredentialsPool(source_credentials)
+
+        token, _ = pool.get_token(request, self.make_boundary())
+        other_token, _ = pool.get_token(
+            request, self.make_boundary(OTHER_AVAILABLE_RESOURCE)
+        )
+
+        assert token == "TOKEN"
+        assert other_token == "OTHER_TOKEN"
+        assert source_credentials._counter == 1
+        assert request.call_count == 2
+
+    def test_get_token_source_credentials_without_expiry(self):
+        request = self.make_mock_request("TOKEN", "OTHER_TOKEN")
+        source_credentials = SourceCredentials(expires_in=None)
+        source_credentials.refresh(None)
+        pool = downscoped.CredentialsPool(source_credentials)
+
+        pool.get_token(request, self.make_boundary())
+        pool.get_token(request, self.make_boundary(OTHER_AVAILABLE_RESOURCE))
+
+        # A token without an expiry may have been revoked, so it isn't reused.
+        assert source_credentials._counter == 3
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_get_token_expired(self, utcnow):
+        utcnow.return_value = datetime.datetime.min
+        request = self.make_mock_request("TOKEN", "NEW_TOKEN")
+        pool = downscoped.CredentialsPool(SourceCredentials(expires_in=7200))
+        pool.get_token(request, self.make_boundary())
+
+        utcnow.return_value = datetime.datetime.min + datetime.timedelta(hours=1)
+        token, _ = pool.get_token(request, self.make_boundary())
+
+        assert token == "NEW_TOKEN"
+        assert request.call_count == 2
+
+    def test_get_token_concurrent(self):
+        request = self.make_mock_request("TOKEN")
+        source_credentials = SourceCredentials()
+        pool = downscoped.CredentialsPool(source_credentials)
+        started = threading.Event()
+        release = threading.Event()
+        refresh = source_credentials.refresh
+
+        def slow_refresh(request):
+            started.set()
+            release.wait(5)
+            refresh(request)
+
+        tokens = []
+
+        def get_token():
+            tokens.append(pool.get_token(request, self.make_boundary())[0])
+
+        with mock.patch.object(source_credentials, "refresh", side_effect=slow_refresh):
+            threads = [threading.Thread(target=get_token) for _ in range(3)]
+            threads[0].start()
+            started.wait(5)
+            for thread in threads[1:]:
+                thread.start()
+            release.set()
+            for thread in threads:
+                thread.join()
+
+        assert tokens == ["TOKEN"] * 3
+        assert source_credentials._counter == 1
+        assert request.call_count == 1
+
+    def test_clear(self):
+        request = self.make_mock_request("TOKEN", "NEW_TOKEN")
+        pool = downscoped.CredentialsPool(SourceCredentials())
+        credentials = pool.get_credentials(self.make_boundary())
+        pool.get_token(request, self.make_boundary())
+
+        pool.clear()
+
+        assert pool.get_credentials(self.make_boundary()) is not credentials
+        assert pool.get_token(request, self.make_boundary())[0] == "NEW_TOKEN"
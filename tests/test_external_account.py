@@ -14,6 +14,7 @@
 
 import datetime
 import json
+import threading
 
 import mock
 import pytest  # type: ignore
@@ -1748,3 +1749,196 @@ class TestCredentials(object):
         assert project_id is None
         # Only 2 requests to STS and cloud resource manager should be sent.
         assert len(request.call_args_list) == 2
+
+    @staticmethod
+    def make_response(data, status=http_client.OK):
+        response = mock.create_autospec(transport.Response, instance=True)
+        response.status = status
+        response.data = json.dumps(data).encode("utf-8")
+        return response
+
+    def test_refresh_shares_sts_token_between_copies(self):
+        request = self.make_mock_request(
+            status=http_client.OK, data=self.SUCCESS_RESPONSE
+        )
+        credentials = self.make_credentials(scopes=self.SCOPES)
+        quota_project_credentials = credentials.with_quota_project(
+            self.QUOTA_PROJECT_ID
+        )
+        # The order of the scopes doesn't matter.
+        scoped_credentials = credentials.with_scopes(list(reversed(self.SCOPES)))
+
+        credentials.refresh(request)
+        quota_project_credentials.refresh(request)
+        scoped_credentials.refresh(request)
+
+        # Only one subject token is retrieved and exchanged.
+        assert len(request.call_args_list) == 1
+        assert credentials._counter == 1
+        assert quota_project_credentials._counter == 0
+        for copied in (quota_project_credentials, scoped_credentials):
+            assert copied.token == credentials.token
+            assert copied.expiry == credentials.expiry
+
+    def test_refresh_does_not_share_sts_token_between_scopes(self):
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = [
+            self.make_response(self.SUCCESS_RESPONSE),
+            self.make_response(dict(self.SUCCESS_RESPONSE, access_token="OTHER")),
+        ]
+        credentials = self.make_credentials(scopes=self.SCOPES)
+        scoped_credentials = credentials.with_scopes(["scope1"])
+
+        credentials.refresh(request)
+        scoped_credentials.refresh(request)
+
+        assert len(request.call_args_list) == 2
+        assert credentials.token == "ACCESS_TOKEN"
+        assert scoped_credentials.token == "OTHER"
+
+    def test_refresh_valid_token_exchanges_again(self):
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = [
+            self.make_response(self.SUCCESS_RESPONSE),
+            self.make_response(dict(self.SUCCESS_RESPONSE, access_token="NEW")),
+        ]
+        credentials = self.make_credentials(scopes=self.SCOPES)
+        copied = credentials.with_quota_project(self.QUOTA_PROJECT_ID)
+        credentials.refresh(request)
+        assert credentials.valid
+
+        # The cached token is the one being replaced, so it isn't reused.
+        credentials.refresh(request)
+        copied.refresh(request)
+
+        assert len(request.call_args_list) == 2
+        assert credentials.token == "NEW"
+        assert copied.token == "NEW"
+
+    def test_refresh_impersonation_shares_sts_token(self):
+        expire_time = (
+            _helpers.utcnow().replace(microsecond=0) + datetime.timedelta(seconds=2800)
+        ).isoformat("T") + "Z"
+        other_impersonation_url = self.SERVICE_ACCOUNT_IMPERSONATION_URL.replace(
+            SERVICE_ACCOUNT_EMAIL, "other@project.iam.gserviceaccount.com"
+        )
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = [
+            self.make_response(self.SUCCESS_RESPONSE),
+            self.make_response({"accessToken": "SA_TOKEN", "expireTime": expire_time}),
+            self.make_response(
+                {"accessToken": "OTHER_SA_TOKEN", "expireTime": expire_time}
+            ),
+        ]
+        credentials = self.make_credentials(
+            service_account_impersonation_url=self.SERVICE_ACCOUNT_IMPERSONATION_URL,
+            scopes=self.SCOPES,
+        )
+        other_credentials = self.make_credentials(
+            service_account_impersonation_url=other_impersonation_url,
+            scopes=["scope1"],
+        )
+
+        credentials.refresh(request)
+        other_credentials.refresh(request)
+
+        # One STS exchange, then one generateAccessToken per service account.
+        assert len(request.call_args_list) == 3
+        assert request.call_args_list[0][1]["url"] == self.TOKEN_URL
+        assert request.call_args_list[2][1]["url"] == other_impersonation_url
+        assert request.call_args_list[2][1]["headers"]["authorization"] == (
+            "Bearer ACCESS_TOKEN"
+        )
+        assert credentials.token == "SA_TOKEN"
+        assert other_credentials.token == "OTHER_SA_TOKEN"
+
+
+class TestStsTokenCache(object):
+    EXPIRY = datetime.datetime.max
+
+    def test_get_token(self):
+        cache = external_account._StsTokenCache()
+        exchange = mock.Mock(return_value=("token", self.EXPIRY))
+
+        assert cache.get_token("key", exchange) == ("token", self.EXPIRY)
+        assert cache.get_token("key", exchange) == ("token", self.EXPIRY)
+
+        exchange.assert_called_once_with()
+
+    def test_get_token_keys(self):
+        cache = external_account._StsTokenCache()
+        exchange = mock.Mock(
+            side_effect=[("token1", self.EXPIRY), ("token2", self.EXPIRY)]
+        )
+
+        assert cache.get_token("key1", exchange)[0] == "token1"
+        assert cache.get_token("key2", exchange)[0] == "token2"
+
+    def test_get_token_expired(self):
+        cache = external_account._StsTokenCache()
+        expiry = _helpers.utcnow() + _helpers.REFRESH_THRESHOLD
+        exchange = mock.Mock(side_effect=[("token1", expiry), ("token2", self.EXPIRY)])
+
+        assert cache.get_token("key", exchange)[0] == "token1"
+        assert cache.get_token("key", exchange)[0] == "token2"
+
+    def test_get_token_stale(self):
+        cache = external_account._StsTokenCache()
+        exchange = mock.Mock(
+            side_effect=[("token1", self.EXPIRY), ("token2", self.EXPIRY)]
+        )
+        cache.get_token("key", exchange)
+
+        assert cache.get_token("key", exchange, stale_token="token1")[0] == "token2"
+        assert cache.get_token("key", exchange, stale_token="token1")[0] == "token2"
+        assert exchange.call_count == 2
+
+    def test_get_token_error(self):
+        cache = external_account._StsTokenCache()
+        exchange = mock.Mock(
+            side_effect=[exceptions.RefreshError(), ("token", self.EXPIRY)]
+        )
+
+        with pytest.raises(exceptions.RefreshError):
+            cache.get_token("key", exchange)
+        assert cache.get_token("key", exchange)[0] == "token"
+
+    def test_get_token_concurrent(self):
+        cache = external_account._StsTokenCache()
+        started = threading.Event()
+        release = threading.Event()
+
+        def exchange():
+            started.set()
+            release.wait(5)
+            return "token", self.EXPIRY
+
+        exchange = mock.Mock(side_effect=exchange)
+        results = []
+        threads = [
+            threading.Thread(
+                target=lambda: results.append(cache.get_token("key", exchange))
+            )
+            for _ in range(3)
+        ]
+        threads[0].start()
+        started.wait(5)
+        for thread in threads[1:]:
+            thread.start()
+        release.set()
+        for thread in threads:
+            thread.join()
+
+        exchange.assert_called_once_with()
+        assert results == [("token", self.EXPIRY)] * 3
+
+    def test_clear(self):
+        cache = external_account._StsTokenCache()
+        exchange = mock.Mock(
+            side_effect=[("token1", self.EXPIRY), ("token2", self.EXPIRY)]
+        )
+        cache.get_token("key", exchange)
+
+        cache.clear()
+
+        assert cache.get_token("key", exchange)[0] == "token2"
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import base64
 import datetime
 import json
 import os
@@ -81,9 +82,10 @@ class TestCredentials(object):
     }
 
     @classmethod
-    def make_mock_response(cls, status, data):
+    def make_mock_response(cls, status, data, headers=None):
         response = mock.create_autospec(transport.Response, instance=True)
         response.status = status
+        response.headers = headers or {}
         if isinstance(data, dict):
             response.data = json.dumps(data).encode("utf-8")
         else:
@@ -630,6 +632,110 @@ class TestCredentials(object):
 
         assert excinfo.match(r"File './not_found.txt' was not found")
 
+    def test_retrieve_subject_token_file_cached(self, tmpdir):
+        token_file = tmpdir.join("token.txt")
+        token_file.write("token-1")
+        credentials = self.make_credentials(
+            credential_source={"file": str(token_file)}
+        )
+
+        with mock.patch.object(
+            credentials, "_parse_token_data", wraps=credentials._parse_token_data
+        ) as parse_token_data:
+            assert credentials.retrieve_subject_token(None) == "token-1"
+            assert credentials.retrieve_subject_token(None) == "token-1"
+
+        assert parse_token_data.call_count == 1
+
+        token_file.write("token-two")
+
+        assert credentials.retrieve_subject_token(None) == "token-two"
+
+    @mock.patch("google.auth._file_watcher.get_watcher", autospec=True)
+    def test_retrieve_subject_token_file_unreadable(self, get_watcher):
+        get_watcher.return_value.read.side_effect = IOError(13, "Permission denied")
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_TEXT
+        )
+
+        with pytest.raises(IOError):
+            credentials.retrieve_subject_token(None)
+
+    def test_watch_credential_source_url(self):
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_TEXT_URL
+        )
+
+        with pytest.raises(ValueError) as excinfo:
+            credentials.watch_credential_source()
+
+        assert excinfo.match(r"Only file-sourced credentials can be watched")
+
+    @classmethod
+    def watch_credential_source(cls, credentials, request=None):
+        with mock.patch(
+            "google.auth._file_watcher.get_watcher", autospec=True
+        ) as get_watcher:
+            credentials.watch_credential_source(request)
+
+        get_watcher.assert_called_once_with(SUBJECT_TOKEN_JSON_FILE)
+        watcher = get_watcher.return_value
+        [[on_change], _] = watcher.subscribe.call_args
+        return watcher, on_change
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_watch_credential_source_expires_credentials(self, utcnow):
+        utcnow.return_value = datetime.datetime.min + datetime.timedelta(hours=1)
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_JSON
+        )
+        credentials.retrieve_subject_token(None)
+        credentials.token = "token"
+        credentials.expiry = utcnow() + datetime.timedelta(hours=1)
+        _, on_change = self.watch_credential_source(credentials)
+
+        # Unchanged or partially written subject tokens are ignored.
+        on_change(json.dumps(JSON_FILE_CONTENT))
+        on_change("{")
+
+        assert credentials.valid
+
+        on_change(json.dumps({SUBJECT_TOKEN_FIELD_NAME: "new-token"}))
+
+        assert credentials.expired
+        assert not credentials.valid
+
+    @mock.patch.object(identity_pool.Credentials, "refresh", autospec=True)
+    def test_watch_credential_source_refreshes(self, refresh):
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_JSON
+        )
+        _, on_change = self.watch_credential_source(
+            credentials, mock.sentinel.request
+        )
+
+        on_change(json.dumps({SUBJECT_TOKEN_FIELD_NAME: "new-token"}))
+
+        refresh.assert_called_once_with(credentials, mock.sentinel.request)
+
+        # Failures are left for the next request to retry.
+        refresh.side_effect = exceptions.RefreshError("failed")
+
+        on_change(json.dumps({SUBJECT_TOKEN_FIELD_NAME: "newer-token"}))
+
+        assert refresh.call_count == 2
+
+    def test_watch_credential_source_garbage_collected(self):
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_JSON
+        )
+        watcher, on_change = self.watch_credential_source(credentials)
+
+        del credentials
+        on_change(json.dumps({SUBJECT_TOKEN_FIELD_NAME: "new-token"}))
+
+        watcher.unsubscribe.assert_called_once_with(on_change)
+
     def test_refresh_text_file_success_without_impersonation_ignore_default_scopes(
         self,
     ):
@@ -952,6 +1058,116 @@ class TestCredentials(object):
             request.call_args_list[0][1], {"foo": "bar"}
         )
 
+    @classmethod
+    def make_jwt(cls, expiry):
+        def encode(data):
+            return base64.urlsafe_b64encode(json.dumps(data).encode("utf-8")).decode(
+                "utf-8"
+            )
+
+        return "{}.{}.c2lnbmF0dXJl".format(
+            encode({"alg": "RS256"}),
+            encode({"exp": _helpers.datetime_to_secs(expiry)}),
+        )
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_retrieve_subject_token_from_url_cache_control(self, utcnow):
+        utcnow.return_value = datetime.datetime(2022, 1, 1)
+        credentials = self.make_credentials(
+            credential_source={"url": self.CREDENTIAL_URL, "headers": {"foo": "bar"}}
+        )
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = [
+            self.make_mock_response(
+                http_client.OK,
+                TEXT_FILE_SUBJECT_TOKEN,
+                {"Cache-Control": "private, max-age=60", "ETag": '"v1"'},
+            ),
+            self.make_mock_response(
+                http_client.NOT_MODIFIED, "", {"cache-control": "max-age=60"}
+            ),
+            self.make_mock_response(http_client.OK, "new-token", {"ETag": '"v2"'}),
+        ]
+
+        assert credentials.retrieve_subject_token(request) == TEXT_FILE_SUBJECT_TOKEN
+        utcnow.return_value += datetime.timedelta(seconds=59)
+        assert credentials.retrieve_subject_token(request) == TEXT_FILE_SUBJECT_TOKEN
+
+        assert request.call_count == 1
+
+        # The token is revalidated once stale.
+        utcnow.return_value += datetime.timedelta(seconds=1)
+
+        assert credentials.retrieve_subject_token(request) == TEXT_FILE_SUBJECT_TOKEN
+        self.assert_credential_request_kwargs(
+            request.call_args_list[1][1], {"foo": "bar", "If-None-Match": '"v1"'}
+        )
+
+        utcnow.return_value += datetime.timedelta(seconds=60)
+
+        assert credentials.retrieve_subject_token(request) == "new-token"
+        self.assert_credential_request_kwargs(
+            request.call_args_list[2][1], {"foo": "bar", "If-None-Match": '"v1"'}
+        )
+
+    @mock.patch("google.auth._helpers.utcnow")
+    def test_retrieve_subject_token_from_url_jwt_expiry(self, utcnow):
+        utcnow.return_value = datetime.datetime(2022, 1, 1)
+        subject_token = self.make_jwt(utcnow() + datetime.timedelta(hours=1))
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_JSON_URL
+        )
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = [
+            self.make_mock_response(
+                http_client.OK,
+                {"access_token": subject_token},
+                {"Last-Modified": "Sat, 01 Jan 2022 00:00:00 GMT"},
+            ),
+            self.make_mock_response(http_client.OK, {"access_token": "new-token"}),
+        ]
+
+        assert credentials.retrieve_subject_token(request) == subject_token
+        utcnow.return_value += datetime.timedelta(minutes=58)
+        assert credentials.retrieve_subject_token(request) == subject_token
+
+        assert request.call_count == 1
+
+        utcnow.return_value += datetime.timedelta(minutes=1)
+
+        assert credentials.retrieve_subject_token(request) == "new-token"
+        self.assert_credential_request_kwargs(
+            request.call_args_list[1][1],
+            {"If-Modified-Since": "Sat, 01 Jan 2022 00:00:00 GMT"},
+        )
+
+    @pytest.mark.parametrize(
+        "cache_control, conditional",
+        [("no-store", False), ("max-age=3600, no-cache", True), (None, True)],
+    )
+    def test_retrieve_subject_token_from_url_not_reused(
+        self, cache_control, conditional
+    ):
+        headers = {"ETag": '"v1"'}
+        if cache_control:
+            headers["Cache-Control"] = cache_control
+        credentials = self.make_credentials(
+            credential_source=self.CREDENTIAL_SOURCE_TEXT_URL
+        )
+        request = mock.create_autospec(transport.Request)
+        request.side_effect = [
+            self.make_mock_response(http_client.OK, TEXT_FILE_SUBJECT_TOKEN, headers),
+            self.make_mock_response(http_client.OK, TEXT_FILE_SUBJECT_TOKEN, headers),
+        ]
+
+        credentials.retrieve_subject_token(request)
+        credentials.retrieve_subject_token(request)
+
+        expected_headers = {"If-None-Match": '"v1"'} if conditional else None
+        self.assert_credential_request_kwargs(
+            request.call_args_list[1][1], expected_headers
+        )
+
     def test_retrieve_subject_token_from_url_not_found(self):
         credentials = self.make_credentials(
             credential_source=self.CREDENTIAL_SOURCE_TEXT_URL
@@ -12,15 +12,18 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import base64
 import datetime
 import json
 import os
+import pickle
 
 # Because Python 2.7
 # from typing import List
 
 import mock
 import pytest  # type: ignore
+import six
 from six.moves import http_client
 
 from google.auth import _helpers
@@ -363,6 +366,103 @@ class TestImpersonatedCredentials(object):
                 credentials.sign_bytes(b"foo")
             assert excinfo.match("'code': 403")
 
+    def test_sign_bytes_reuses_session(self, mock_authorizedsession_sign):
+        credentials = self.make_credentials(
+            source_credentials=self.USER_SOURCE_CREDENTIALS
+        )
+
+        credentials.sign_bytes(b"foo")
+        session = credentials._signing_session
+        credentials.sign_bytes(b"bar")
+
+        assert credentials._signing_session is session
+        assert [call[0][0] for call in mock_authorizedsession_sign.call_args_list] == [
+            session,
+            session,
+        ]
+
+    def test_sign_bytes_many(self):
+        credentials = self.make_credentials(
+            source_credentials=self.USER_SOURCE_CREDENTIALS
+        )
+
+        def sign(session, method, url, json=None, **kwargs):
+            payload = base64.b64decode(json["payload"])
+            signature = base64.b64encode(payload[::-1]).decode("utf-8")
+            return MockResponse({"signedBlob": signature}, http_client.OK)
+
+        messages = [six.b("message-{}".format(index)) for index in range(25)]
+        with mock.patch(
+            "google.auth.transport.requests.AuthorizedSession.request",
+            autospec=True,
+            side_effect=sign,
+        ) as auth_session:
+            signatures = credentials.sign_bytes_many(messages, max_concurrency=4)
+
+        assert signatures == [message[::-1] for message in messages]
+        assert auth_session.call_count == 25
+        assert len(set(call[0][0] for call in auth_session.call_args_list)) == 1
+
+    def test_sign_bytes_many_empty(self, mock_authorizedsession_sign):
+        credentials = self.make_credentials()
+
+        assert credentials.sign_bytes_many([]) == []
+        mock_authorizedsession_sign.assert_not_called()
+
+    def test_sign_bytes_many_failure(self):
+        credentials = self.make_credentials(
+            source_credentials=self.USER_SOURCE_CREDENTIALS
+        )
+
+        def sign(session, method, url, json=None, **kwargs):
+            if json["payload"] == base64.b64encode(b"bad").decode("utf-8"):
+                data = {"error": {"code": 403, "message": "unauthorized"}}
+                return MockResponse(data, http_client.FORBIDDEN)
+            return MockResponse({"signedBlob": "c2lnbmF0dXJl"}, http_client.OK)
+
+        with mock.patch(
+            "google.auth.transport.requests.AuthorizedSession.request",
+            autospec=True,
+            side_effect=sign,
+        ):
+            with pytest.raises(exceptions.TransportError) as excinfo:
+                credentials.sign_bytes_many([b"foo", b"bad", b"bar"])
+        assert excinfo.match("'code': 403")
+
+    def test_sign_bytes_many_invalid_max_concurrency(
+        self, mock_authorizedsession_sign
+    ):
+        credentials = self.make_credentials()
+
+        with pytest.raises(ValueError, match="max_concurrency"):
+            credentials.sign_bytes_many([b"foo"], max_concurrency=0)
+        mock_authorizedsession_sign.assert_not_called()
+
+    def test_pickle_and_unpickle(self, mock_authorizedsession_sign):
+        credentials = self.make_credentials(
+            source_credentials=self.USER_SOURCE_CREDENTIALS
+        )
+        credentials.sign_bytes(b"foo")
+        assert credentials._signing_session is not None
+
+        unpickled = pickle.loads(pickle.dumps(credentials))
+
+        assert unpickled._signing_session is None
+        assert unpickled.signer_email == credentials.signer_email
+        assert unpickled._source_credentials.token == "ABCDE"
+        unpickled.sign_bytes(b"bar")
+        assert unpickled._signing_session is not None
+
+    def test_unpickle_old_credentials(self):
+        credentials = self.make_credentials()
+        state = credentials.__getstate__()
+        del state["_signing_session"]
+
+        unpickled = Credentials.__new__(Credentials)
+        unpickled.__setstate__(state)
+
+        assert unpickled._signing_session is None
+
     def test_with_quota_project(self):
         credentials = self.make_credentials()
 
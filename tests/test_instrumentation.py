@@ -0,0 +1,186 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import sys
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import credentials
+from google.auth import instrumentation
+from google.auth import warmup
+from google.oauth2 import id_token
+from tests.oauth2 import test_id_token
+
+
+class RecordingInstrumentation(instrumentation.Instrumentation):
+    def __init__(self):
+        self.records = []
+
+    def record(self, name, duration, attributes, error=None):
+        self.records.append((name, duration, attributes, error))
+
+
+class CredentialsStub(credentials.Credentials):
+    def refresh(self, request):
+        self.token = "token"
+
+
+@pytest.fixture
+def recorder():
+    recorder = RecordingInstrumentation()
+    instrumentation.set_instrumentation(recorder)
+    yield recorder
+    instrumentation.set_instrumentation(None)
+
+
+def test_span_disabled():
+    assert instrumentation.get_instrumentation() is None
+    assert instrumentation._span("name") is instrumentation._NO_OP_SPAN
+    with instrumentation._span("name"):
+        pass
+
+
+def test_span(recorder):
+    with instrumentation._span("name", key="value"):
+        pass
+
+    assert instrumentation.get_instrumentation() is recorder
+    [(name, duration, attributes, error)] = recorder.records
+    assert name == "name"
+    assert duration >= 0
+    assert attributes == {"key": "value"}
+    assert error is None
+
+
+@mock.patch("google.auth.instrumentation._perf_counter", autospec=True)
+def test_span_duration(perf_counter, recorder):
+    perf_counter.side_effect = [1.0, 3.5]
+
+    with instrumentation._span("name"):
+        pass
+
+    assert recorder.records[0][1] == 2.5
+
+
+def test_span_error(recorder):
+    error = ValueError("failed")
+    with pytest.raises(ValueError):
+        with instrumentation._span("name"):
+            raise error
+
+    assert recorder.records[0][3] is error
+
+
+def test_instrumentation_record_default():
+    with instrumentation.Instrumentation().start_span("name", {}):
+        pass
+
+
+def test_traced(recorder):
+    @instrumentation._traced("name")
+    def func(value):
+        return value
+
+    assert func(mock.sentinel.value) == mock.sentinel.value
+    assert [record[0] for record in recorder.records] == ["name"]
+
+
+def test_traced_disabled():
+    func = mock.Mock(return_value=mock.sentinel.value)
+    traced = instrumentation._traced("name")(func)
+
+    assert traced(1, key=2) == mock.sentinel.value
+    func.assert_called_once_with(1, key=2)
+
+
+def test_credentials_refresh(recorder):
+    credentials = CredentialsStub()
+
+    credentials.before_request(mock.sentinel.request, "GET", "https://example.com", {})
+    credentials.before_request(mock.sentinel.request, "GET", "https://example.com", {})
+
+    [(name, _, attributes, _)] = recorder.records
+    assert name == "google.auth.credentials.refresh"
+    assert attributes == {"credentials": "CredentialsStub"}
+
+
+def test_traced_refresh(recorder):
+    credentials = CredentialsStub()
+
+    instrumentation._traced_refresh(credentials, mock.sentinel.request)
+
+    assert credentials.token == "token"
+    [(name, _, attributes, _)] = recorder.records
+    assert name == "google.auth.credentials.refresh"
+    assert attributes == {"credentials": "CredentialsStub"}
+
+
+def test_warm_up_refresh(recorder):
+    warmup.warm_up(mock.sentinel.request, credentials=[CredentialsStub()])
+
+    assert [record[0] for record in recorder.records] == [
+        "google.auth.credentials.refresh"
+    ]
+
+
+def test_id_token_provider_refresh(recorder):
+    provider = id_token.IDTokenProvider(test_id_token.IDTokenCredentialsStub())
+
+    provider.get_token(mock.sentinel.request, "audience")
+
+    [(name, _, attributes, _)] = recorder.records
+    assert name == "google.auth.credentials.refresh"
+    assert attributes == {"credentials": "IDTokenCredentialsStub"}
+
+
+class TestOpenTelemetryInstrumentation(object):
+    def test_missing_dependency(self, monkeypatch):
+        monkeypatch.setitem(sys.modules, "opentelemetry", None)
+
+        with pytest.raises(ImportError) as excinfo:
+            instrumentation.OpenTelemetryInstrumentation()
+
+        assert excinfo.match("google-auth\\[opentelemetry\\]")
+
+    def test_span(self, mock_non_existent_module):
+        mock_non_existent_module("opentelemetry.trace")
+        mock_non_existent_module("opentelemetry.metrics")
+        from opentelemetry import metrics  # type: ignore
+        from opentelemetry import trace  # type: ignore
+
+        otel = instrumentation.OpenTelemetryInstrumentation(
+            tracer_provider=mock.sentinel.tracer_provider,
+            meter_provider=mock.sentinel.meter_provider,
+        )
+
+        trace.get_tracer.assert_called_once_with(
+            "google.auth.instrumentation",
+            mock.ANY,
+            tracer_provider=mock.sentinel.tracer_provider,
+        )
+        histogram = metrics.get_meter.return_value.create_histogram.return_value
+
+        with pytest.raises(ValueError):
+            with otel.start_span("name", {"key": "value"}):
+                raise ValueError()
+
+        tracer = trace.get_tracer.return_value
+        tracer.start_as_current_span.assert_called_once_with(
+            "name", attributes={"key": "value"}
+        )
+        histogram.record.assert_called_once_with(
+            mock.ANY,
+            attributes={"key": "value", "operation": "name", "error": "ValueError"},
+        )
@@ -16,6 +16,8 @@
 import json
 import os
 import subprocess
+import threading
+import time
 
 import mock
 import pytest  # type: ignore
@@ -24,6 +26,8 @@ import pytest  # type: ignore
 # from six.moves import urllib
 
 # from google.auth import _helpers
+from google.auth import _executable_daemon
+from google.auth import _file_lock
 from google.auth import exceptions
 from google.auth import pluggable
 
@@ -49,6 +53,12 @@ SUBJECT_TOKEN_TYPE = "urn:ietf:params:oauth:token-type:jwt"
 AUDIENCE = "//iam.googleapis.com/projects/123456/locations/global/workloadIdentityPools/POOL_ID/providers/PROVIDER_ID"
 
 
+@pytest.fixture(autouse=True)
+def working_directory(tmpdir, monkeypatch):
+    # The output files and their locks are created in the working directory.
+    monkeypatch.chdir(tmpdir)
+
+
 class TestCredentials(object):
     CREDENTIAL_SOURCE_EXECUTABLE_COMMAND = (
         "/fake/external/excutable --arg1=value1 --arg2=value2"
@@ -750,3 +760,179 @@ class TestCredentials(object):
                 _ = credentials.retrieve_subject_token(None)
 
             assert excinfo.match(r"Pluggable auth is only supported for python 3.6+")
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_daemon(self):
+        credential_source = {
+            "executable": {
+                "command": self.CREDENTIAL_SOURCE_EXECUTABLE_COMMAND,
+                "timeout_millis": 30000,
+                "daemon": True,
+            }
+        }
+        daemon = mock.create_autospec(
+            _executable_daemon.ExecutableDaemon, instance=True
+        )
+        daemon.request.return_value = self.EXECUTABLE_SUCCESSFUL_SAML_RESPONSE
+
+        with mock.patch(
+            "google.auth._executable_daemon.get_daemon", return_value=daemon
+        ) as get_daemon, mock.patch("subprocess.run") as run:
+            credentials = self.make_pluggable(
+                service_account_impersonation_url=SERVICE_ACCOUNT_IMPERSONATION_URL,
+                credential_source=credential_source,
+            )
+
+            subject_token = credentials.retrieve_subject_token(None)
+
+        assert subject_token == self.EXECUTABLE_SAML_TOKEN
+        run.assert_not_called()
+        args, env = get_daemon.call_args[0]
+        assert args == self.CREDENTIAL_SOURCE_EXECUTABLE_COMMAND.split()
+        assert env["GOOGLE_EXTERNAL_ACCOUNT_DAEMON"] == "1"
+        assert env["GOOGLE_EXTERNAL_ACCOUNT_AUDIENCE"] == AUDIENCE
+        daemon.request.assert_called_once_with(
+            {
+                "version": 1,
+                "audience": AUDIENCE,
+                "subject_token_type": SUBJECT_TOKEN_TYPE,
+                "interactive": False,
+                "impersonated_email": credentials.service_account_email,
+            },
+            30,
+        )
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_daemon_failed(self):
+        credential_source = {
+            "executable": dict(self.CREDENTIAL_SOURCE_EXECUTABLE, daemon=True)
+        }
+        daemon = mock.create_autospec(
+            _executable_daemon.ExecutableDaemon, instance=True
+        )
+        daemon.request.return_value = self.EXECUTABLE_FAILED_RESPONSE
+
+        with mock.patch(
+            "google.auth._executable_daemon.get_daemon", return_value=daemon
+        ):
+            credentials = self.make_pluggable(credential_source=credential_source)
+
+            with pytest.raises(exceptions.RefreshError) as excinfo:
+                _ = credentials.retrieve_subject_token(None)
+
+        assert excinfo.match(r"Executable returned unsuccessful response")
+        assert daemon.request.call_args[0][0]["output_file"] == (
+            self.CREDENTIAL_SOURCE_EXECUTABLE_OUTPUT_FILE
+        )
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_writes_output_file(self):
+        with mock.patch(
+            "subprocess.run",
+            return_value=subprocess.CompletedProcess(
+                args=[],
+                stdout=json.dumps(
+                    self.EXECUTABLE_SUCCESSFUL_OIDC_RESPONSE_ID_TOKEN
+                ).encode("UTF-8"),
+                returncode=0,
+            ),
+        ) as run:
+            credentials = self.make_pluggable(credential_source=self.CREDENTIAL_SOURCE)
+
+            assert credentials.retrieve_subject_token(None) == (
+                self.EXECUTABLE_OIDC_TOKEN
+            )
+            # The second refresh reads the response from the output file.
+            assert credentials.retrieve_subject_token(None) == (
+                self.EXECUTABLE_OIDC_TOKEN
+            )
+
+        run.assert_called_once()
+        with open(self.CREDENTIAL_SOURCE_EXECUTABLE_OUTPUT_FILE) as output_file:
+            assert json.load(output_file) == (
+                self.EXECUTABLE_SUCCESSFUL_OIDC_RESPONSE_ID_TOKEN
+            )
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_failed_does_not_write_output_file(self):
+        with mock.patch(
+            "subprocess.run",
+            return_value=subprocess.CompletedProcess(
+                args=[],
+                stdout=json.dumps(self.EXECUTABLE_FAILED_RESPONSE).encode("UTF-8"),
+                returncode=0,
+            ),
+        ):
+            credentials = self.make_pluggable(credential_source=self.CREDENTIAL_SOURCE)
+
+            with pytest.raises(exceptions.RefreshError):
+                _ = credentials.retrieve_subject_token(None)
+
+        assert not os.path.exists(self.CREDENTIAL_SOURCE_EXECUTABLE_OUTPUT_FILE)
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_concurrent_runs_once(self):
+        def run(*args, **kwargs):
+            # Give the other threads time to wait for the lock.
+            time.sleep(0.2)
+            return subprocess.CompletedProcess(
+                args=[],
+                stdout=json.dumps(
+                    self.EXECUTABLE_SUCCESSFUL_OIDC_RESPONSE_ID_TOKEN
+                ).encode("UTF-8"),
+                returncode=0,
+            )
+
+        subject_tokens = []
+
+        def retrieve():
+            credentials = self.make_pluggable(credential_source=self.CREDENTIAL_SOURCE)
+            subject_tokens.append(credentials.retrieve_subject_token(None))
+
+        with mock.patch("subprocess.run", side_effect=run) as mock_run:
+            threads = [threading.Thread(target=retrieve) for _ in range(4)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+
+        assert mock_run.call_count == 1
+        assert subject_tokens == [self.EXECUTABLE_OIDC_TOKEN] * 4
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_lock_timeout(self):
+        credentials = self.make_pluggable(credential_source=self.CREDENTIAL_SOURCE)
+
+        with mock.patch.object(
+            _file_lock.FileLock, "acquire", return_value=False
+        ) as acquire, mock.patch("subprocess.run") as run:
+            with pytest.raises(exceptions.RefreshError) as excinfo:
+                _ = credentials.retrieve_subject_token(None)
+
+        acquire.assert_called_once_with(60)
+        assert excinfo.match(r"Timed out waiting for another process")
+        run.assert_not_called()
+
+    @mock.patch.dict(os.environ, {"GOOGLE_EXTERNAL_ACCOUNT_ALLOW_EXECUTABLES": "1"})
+    def test_retrieve_subject_token_unable_to_lock(self):
+        credential_source = {
+            "executable": dict(
+                self.CREDENTIAL_SOURCE_EXECUTABLE,
+                output_file=os.path.join("missing", "output_file"),
+            )
+        }
+        with mock.patch(
+            "subprocess.run",
+            return_value=subprocess.CompletedProcess(
+                args=[],
+                stdout=json.dumps(
+                    self.EXECUTABLE_SUCCESSFUL_OIDC_RESPONSE_ID_TOKEN
+                ).encode("UTF-8"),
+                returncode=0,
+            ),
+        ):
+            credentials = self.make_pluggable(credential_source=credential_source)
+
+            subject_token = credentials.retrieve_subject_token(None)
+
+        assert subject_token == self.EXECUTABLE_OIDC_TOKEN
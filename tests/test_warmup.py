@@ -0,0 +1,192 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import threading
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import credentials
+from google.auth import exceptions
+from google.auth import warmup
+
+
+class CredentialsStub(credentials.Credentials):
+    def __init__(self, barrier=None, error=None):
+        super(CredentialsStub, self).__init__()
+        self.barrier = barrier
+        self.error = error
+        self.refresh_count = 0
+
+    def refresh(self, request):
+        self.refresh_count += 1
+        if self.barrier is not None:
+            self.barrier.wait()
+        if self.error is not None:
+            raise self.error
+        self.token = "token"
+
+
+class Barrier(object):
+    """Waits until a number of threads are waiting (threading.Barrier is not
+    available on Python 2)."""
+
+    def __init__(self, parties):
+        self._parties = parties
+        self._condition = threading.Condition()
+
+    def wait(self):
+        with self._condition:
+            self._parties -= 1
+            self._condition.notify_all()
+            while self._parties > 0:
+                self._condition.wait(5)
+
+
+def test_warm_up_credentials_mapping():
+    creds = {"first": CredentialsStub(), "second": CredentialsStub()}
+
+    report = warmup.warm_up(mock.sentinel.request, credentials=creds)
+
+    assert report.ok
+    assert report.failures == []
+    assert [result.name for result in report] == ["first", "second"]
+    assert all(result.done and result.duration >= 0 for result in report)
+    assert report.duration >= 0
+    assert creds["first"].valid and creds["second"].valid
+
+
+def test_warm_up_credentials_sequence():
+    report = warmup.warm_up(mock.sentinel.request, credentials=[CredentialsStub()])
+
+    assert [result.name for result in report] == ["CredentialsStub"]
+
+
+def test_warm_up_concurrent():
+    barrier = Barrier(3)
+    creds = [CredentialsStub(barrier=barrier) for _ in range(3)]
+
+    # Deadlocks unless the refreshes run concurrently.
+    report = warmup.warm_up(mock.sentinel.request, credentials=creds, deadline=10)
+
+    assert report.ok
+
+
+def test_warm_up_skips_valid_credentials():
+    creds = CredentialsStub()
+    creds.token = "token"
+
+    assert warmup.warm_up(mock.sentinel.request, credentials=[creds]).ok
+    assert creds.refresh_count == 0
+
+
+def test_warm_up_failure():
+    error = exceptions.RefreshError("failed")
+    creds = {"bad": CredentialsStub(error=error), "good": CredentialsStub()}
+
+    report = warmup.warm_up(mock.sentinel.request, credentials=creds)
+
+    assert not report.ok
+    [failure] = report.failures
+    assert failure.name == "bad"
+    assert failure.done
+    assert failure.error is error
+    assert "bad" in repr(failure)
+
+
+def test_warm_up_async_credentials():
+    _credentials_async = pytest.importorskip(
+        "google.auth.compute_engine._credentials_async"
+    )
+    creds = {"async": _credentials_async.Credentials(), "sync": CredentialsStub()}
+
+    with pytest.raises(ValueError) as excinfo:
+        warmup.warm_up(mock.sentinel.request, credentials=creds)
+
+    assert excinfo.match("async")
+    assert creds["sync"].refresh_count == 0
+
+
+def test_warm_up_awaitable_refresh():
+    asyncio = pytest.importorskip("asyncio")
+    creds = CredentialsStub()
+    creds.refresh = lambda request: asyncio.sleep(0)
+
+    report = warmup.warm_up(mock.sentinel.request, credentials={"async": creds})
+
+    [failure] = report.failures
+    assert isinstance(failure.error, exceptions.RefreshError)
+    assert failure.error.args[0].startswith("Refreshing the credentials returned")
+
+
+def test_warm_up_deadline():
+    release = threading.Event()
+
+    class SlowCredentials(CredentialsStub):
+        def refresh(self, request):
+            release.wait(5)
+            self.token = "token"
+
+    try:
+        report = warmup.warm_up(
+            mock.sentinel.request,
+            credentials={"slow": SlowCredentials(), "fast": CredentialsStub()},
+            deadline=0.1,
+        )
+    finally:
+        release.set()
+
+    [failure] = report.failures
+    assert failure.name == "slow"
+    assert not failure.done
+    assert isinstance(failure.error, exceptions.RefreshError)
+    assert failure.error.args[0] == (
+        "Warming up slow did not finish before the deadline."
+    )
+    assert report.duration < 5
+
+
+@mock.patch("google.oauth2.id_token.fetch_id_token", autospec=True)
+def test_warm_up_audiences(fetch_id_token):
+    report = warmup.warm_up(mock.sentinel.request, audiences=["aud1", "aud2"])
+
+    assert report.ok
+    assert [result.name for result in report] == ["aud1", "aud2"]
+    fetch_id_token.assert_has_calls(
+        [
+            mock.call(mock.sentinel.request, "aud1"),
+            mock.call(mock.sentinel.request, "aud2"),
+        ],
+        any_order=True,
+    )
+
+
+def test_warm_up_audiences_provider():
+    provider = mock.Mock(spec=["get_token"])
+    provider.get_token.side_effect = exceptions.RefreshError("failed")
+
+    report = warmup.warm_up(
+        mock.sentinel.request,
+        credentials=[CredentialsStub()],
+        audiences=["aud"],
+        id_token_provider=provider,
+    )
+
+    assert [result.name for result in report.failures] == ["aud"]
+    provider.get_token.assert_called_once_with(mock.sentinel.request, "aud")
+
+
+@pytest.mark.parametrize("done, error, ok", [(True, None, True), (False, None, False)])
+def test_result_ok(done, error, ok):
+    assert warmup.WarmUpResult("name", 0, error, done).ok is ok
@@ -14,6 +14,7 @@
 
 import datetime
 import os
+import threading
 import time
 
 import mock
@@ -23,6 +24,8 @@ from google.auth import _helpers
 from google.auth import credentials
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth import instrumentation
+from google.auth import jwt
 from google.auth import transport
 from google.oauth2 import service_account
 
@@ -36,6 +39,7 @@ except ImportError:  # pragma: NO COVER
     HAS_GRPC = False
 
 DATA_DIR = os.path.join(os.path.dirname(__file__), "..", "data")
+SERVICE_ACCOUNT_JSON_FILE = os.path.join(DATA_DIR, "service_account.json")
 METADATA_PATH = os.path.join(DATA_DIR, "context_aware_metadata.json")
 with open(os.path.join(DATA_DIR, "privatekey.pem"), "rb") as fh:
     PRIVATE_KEY_BYTES = fh.read()
@@ -45,6 +49,14 @@ with open(os.path.join(DATA_DIR, "public_cert.pem"), "rb") as fh:
 pytestmark = pytest.mark.skipif(not HAS_GRPC, reason="gRPC is unavailable.")
 
 
+def wait_for_calls(*callbacks):
+    """Waits for the callbacks run by the refresh executor."""
+    deadline = time.time() + 5
+    while not all(callback.called for callback in callbacks):
+        assert time.time() < deadline
+        time.sleep(0.001)
+
+
 class CredentialsStub(credentials.Credentials):
     def __init__(self, token="token"):
         super(CredentialsStub, self).__init__()
@@ -99,8 +111,101 @@ class TestAuthMetadataPlugin(object):
             [("authorization", "Bearer {}".format(credentials.token))], None
         )
 
+    def test_call_refresh_coalesced(self):
+        credentials = CredentialsStub(token=None)
+        release = threading.Event()
+        refresh = mock.Mock(side_effect=lambda request: release.wait())
+        credentials.refresh = refresh
+        request = mock.create_autospec(transport.Request)
+
+        plugin = google.auth.transport.grpc.AuthMetadataPlugin(credentials, request)
+
+        context = mock.create_autospec(grpc.AuthMetadataContext, instance=True)
+        callbacks = [
+            mock.create_autospec(grpc.AuthMetadataPluginCallback) for _ in range(3)
+        ]
+
+        # The plugin returns without waiting for the refresh.
+        for callback in callbacks:
+            plugin(context, callback)
+        for callback in callbacks:
+            callback.assert_not_called()
+
+        credentials.token = "token"
+        release.set()
+        wait_for_calls(*callbacks)
+
+        refresh.assert_called_once_with(request)
+        for callback in callbacks:
+            callback.assert_called_once_with([("authorization", "Bearer token")], None)
+
+    def test_call_refresh_error(self):
+        credentials = CredentialsStub(token=None)
+        error = exceptions.RefreshError("failed")
+        credentials.refresh = mock.Mock(side_effect=error)
+        request = mock.create_autospec(transport.Request)
+
+        plugin = google.auth.transport.grpc.AuthMetadataPlugin(credentials, request)
+
+        context = mock.create_autospec(grpc.AuthMetadataContext, instance=True)
+        callback = mock.create_autospec(grpc.AuthMetadataPluginCallback)
+
+        plugin(context, callback)
+        wait_for_calls(callback)
+
+        callback.assert_called_once_with((), error)
+
+    def test_call_refresh_traced(self):
+        credentials = CredentialsStub(token=None)
+        credentials.refresh = mock.Mock(
+            side_effect=lambda request: setattr(credentials, "token", "token")
+        )
+        plugin = google.auth.transport.grpc.AuthMetadataPlugin(
+            credentials, mock.sentinel.request
+        )
+        context = mock.create_autospec(grpc.AuthMetadataContext, instance=True)
+        callback = mock.create_autospec(grpc.AuthMetadataPluginCallback)
+        recorder = mock.create_autospec(instrumentation.Instrumentation, instance=True)
+        instrumentation.set_instrumentation(recorder)
+        try:
+            plugin(context, callback)
+            wait_for_calls(callback)
+        finally:
+            instrumentation.set_instrumentation(None)
+
+        recorder.start_span.assert_called_once_with(
+            "google.auth.credentials.refresh", {"credentials": "CredentialsStub"}
+        )
+
+    def test_refresh_executor_shared(self):
+        credentials = CredentialsStub(token=None)
+        credentials.refresh = mock.Mock(
+            side_effect=lambda request: setattr(credentials, "token", "token")
+        )
+        request = mock.create_autospec(transport.Request)
+        plugins = [
+            google.auth.transport.grpc.AuthMetadataPlugin(credentials, request)
+            for _ in range(2)
+        ]
+        context = mock.create_autospec(grpc.AuthMetadataContext, instance=True)
+        callbacks = [
+            mock.create_autospec(grpc.AuthMetadataPluginCallback) for _ in plugins
+        ]
+
+        for plugin, callback in zip(plugins, callbacks):
+            credentials.token = None
+            plugin(context, callback)
+            wait_for_calls(callback)
+            callback.assert_called_once_with([("authorization", "Bearer token")], None)
+
+        # The plugins don't own an executor, so channels don't leak threads.
+        executor = google.auth.transport.grpc._get_refresh_executor()
+        assert google.auth.transport.grpc._get_refresh_executor() is executor
+        assert not hasattr(plugins[0], "_refresh_executor")
+
     def test__get_authorization_headers_with_service_account(self):
         credentials = mock.create_autospec(service_account.Credentials)
+        credentials._subject = None
         request = mock.create_autospec(transport.Request)
 
         plugin = google.auth.transport.grpc.AuthMetadataPlugin(credentials, request)
@@ -111,10 +216,11 @@ class TestAuthMetadataPlugin(object):
 
         plugin._get_authorization_headers(context)
 
-        credentials._create_self_signed_jwt.assert_called_once_with(None)
+        credentials._get_self_signed_jwt_credentials.assert_called_once_with(None)
 
     def test__get_authorization_headers_with_service_account_and_default_host(self):
         credentials = mock.create_autospec(service_account.Credentials)
+        credentials._subject = None
         request = mock.create_autospec(transport.Request)
 
         default_host = "pubsub.googleapis.com"
@@ -128,10 +234,70 @@ class TestAuthMetadataPlugin(object):
 
         plugin._get_authorization_headers(context)
 
-        credentials._create_self_signed_jwt.assert_called_once_with(
+        credentials._get_self_signed_jwt_credentials.assert_called_once_with(
             "https://{}/".format(default_host)
         )
 
+    def test__get_authorization_headers_with_service_account_shared(self):
+        credentials = service_account.Credentials.from_service_account_file(
+            SERVICE_ACCOUNT_JSON_FILE
+        )
+        request = mock.create_autospec(transport.Request)
+
+        plugin = google.auth.transport.grpc.AuthMetadataPlugin(
+            credentials, request, default_host="pubsub.googleapis.com"
+        )
+        other_plugin = google.auth.transport.grpc.AuthMetadataPlugin(
+            credentials, request, default_host="storage.googleapis.com"
+        )
+
+        context = mock.create_autospec(grpc.AuthMetadataContext, instance=True)
+        context.method_name = "methodName"
+        context.service_url = "https://example.com/methodName"
+
+        def audience(plugin):
+            headers = dict(plugin._get_authorization_headers(context))
+            token = headers["authorization"].split(" ", 1)[1]
+            return jwt.decode(token, verify=False)["aud"]
+
+        # Each plugin sends a JWT for its own host, even though the plugins
+        # share the credentials.
+        assert audience(plugin) == "https://pubsub.googleapis.com/"
+        assert audience(other_plugin) == "https://storage.googleapis.com/"
+        assert audience(plugin) == "https://pubsub.googleapis.com/"
+        request.assert_not_called()
+
+    def test_call_with_service_account_shared(self):
+        credentials = service_account.Credentials.from_service_account_file(
+            SERVICE_ACCOUNT_JSON_FILE
+        )
+        request = mock.create_autospec(transport.Request)
+        plugin = google.auth.transport.grpc.AuthMetadataPlugin(
+            credentials, request, default_host="pubsub.googleapis.com"
+        )
+        other_plugin = google.auth.transport.grpc.AuthMetadataPlugin(
+            credentials, request, default_host="storage.googleapis.com"
+        )
+        context = mock.create_autospec(grpc.AuthMetadataContext, instance=True)
+        context.method_name = "methodName"
+        context.service_url = "https://example.com/methodName"
+
+        audiences = []
+        for current in (plugin, other_plugin, plugin):
+            callback = mock.create_autospec(grpc.AuthMetadataPluginCallback)
+            current(context, callback)
+            wait_for_calls(callback)
+            headers = dict(callback.call_args[0][0])
+            token = headers["authorization"].split(" ", 1)[1]
+            audiences.append(jwt.decode(token, verify=False)["aud"])
+
+        assert audiences == [
+            "https://pubsub.googleapis.com/",
+            "https://storage.googleapis.com/",
+            "https://pubsub.googleapis.com/",
+        ]
+        request.assert_not_called()
+
 
 @mock.patch(
     "google.auth.transport._mtls_helper.get_client_ssl_credentials", autospec=True
@@ -0,0 +1,193 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import datetime
+
+import aiohttp  # type: ignore
+import mock
+import pytest  # type: ignore
+
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth import jwt
+from google.auth.compute_engine import _credentials_async as credentials
+from google.auth.compute_engine import fake_metadata_server
+from google.auth.transport import _aiohttp_requests as aiohttp_requests
+from tests.compute_engine import test_credentials
+
+EMAIL = "service-account@example.com"
+
+
+@pytest.fixture
+def get():
+    with mock.patch(
+        "google.auth.compute_engine._metadata_async.get", new_callable=mock.AsyncMock
+    ) as get:
+        yield get
+
+
+class TestCredentials(object):
+    @pytest.mark.asyncio
+    @mock.patch(
+        "google.auth._helpers.utcnow",
+        return_value=datetime.datetime.min + _helpers.REFRESH_THRESHOLD,
+    )
+    async def test_refresh_success(self, utcnow, get):
+        get.side_effect = [
+            {"email": EMAIL, "scopes": ["one", "two"]},
+            {"access_token": "token", "expires_in": 500},
+        ]
+        creds = credentials.Credentials()
+
+        await creds.refresh(None)
+
+        assert creds.token == "token"
+        assert creds.expiry == (utcnow() + datetime.timedelta(seconds=500))
+        assert creds.service_account_email == EMAIL
+        assert creds._scopes == ["one", "two"]
+        assert get.call_args_list[1] == mock.call(
+            None,
+            "instance/service-accounts/{}/token".format(EMAIL),
+            params=None,
+        )
+
+    @pytest.mark.asyncio
+    async def test_refresh_info_retrieved_once(self, get):
+        get.side_effect = [
+            {"email": EMAIL, "scopes": ["one"]},
+            {"access_token": "token", "expires_in": 500},
+            {"access_token": "new-token", "expires_in": 500},
+        ]
+        creds = credentials.Credentials()
+
+        await creds.refresh(None)
+        await creds.refresh(None)
+
+        assert creds.token == "new-token"
+        assert get.call_count == 3
+
+    @pytest.mark.asyncio
+    async def test_refresh_error(self, get):
+        get.side_effect = exceptions.TransportError("http error")
+
+        with pytest.raises(exceptions.RefreshError) as excinfo:
+            await credentials.Credentials().refresh(None)
+
+        assert excinfo.match(r"http error")
+
+    @pytest.mark.asyncio
+    async def test_before_request(self, get):
+        get.side_effect = [
+            {"email": EMAIL, "scopes": ["one"]},
+            {"access_token": "token", "expires_in": 500},
+        ]
+        creds = credentials.Credentials()
+        headers = {}
+
+        await creds.before_request(None, "GET", "https://example.com", headers)
+
+        assert headers["authorization"] == "Bearer token"
+
+    @pytest.mark.asyncio
+    async def test_scoped_copies_share_token(self, get):
+        get.side_effect = [
+            {"email": EMAIL, "scopes": ["one"]},
+            {"access_token": "token", "expires_in": 500},
+            {"email": EMAIL, "scopes": ["one"]},
+        ]
+        first = credentials.Credentials().with_scopes(["a", "b"])
+        second = first.with_scopes(["b", "a"])
+
+        await first.refresh(None)
+        await second.refresh(None)
+
+        assert isinstance(second, credentials.Credentials)
+        assert second.token == first.token == "token"
+
+    def test_with_quota_project(self):
+        creds = credentials.Credentials().with_quota_project("project")
+
+        assert isinstance(creds, credentials.Credentials)
+        assert creds.quota_project_id == "project"
+
+
+class TestIDTokenCredentials(object):
+    def test_constructor(self):
+        creds = credentials.IDTokenCredentials(None, "audience")
+
+        assert creds._target_audience == "audience"
+        assert creds._use_metadata_identity_endpoint
+        assert creds.service_account_email == "default"
+        with pytest.raises(ValueError):
+            creds.sign_bytes(b"message")
+
+    def test_constructor_without_metadata_identity_endpoint(self):
+        with pytest.raises(ValueError):
+            credentials.IDTokenCredentials(
+                None, "audience", use_metadata_identity_endpoint=False
+            )
+
+    @pytest.mark.asyncio
+    async def test_refresh(self, get):
+        get.return_value = test_credentials.SAMPLE_ID_TOKEN
+        creds = credentials.IDTokenCredentials(None, "audience")
+
+        await creds.refresh(None)
+
+        assert creds.token == test_credentials.SAMPLE_ID_TOKEN
+        assert creds.expiry == datetime.datetime.utcfromtimestamp(
+            test_credentials.SAMPLE_ID_TOKEN_EXP
+        )
+        get.assert_called_once_with(
+            None,
+            "instance/service-accounts/default/identity",
+            params={"audience": "audience", "format": "full"},
+        )
+
+    @pytest.mark.asyncio
+    async def test_refresh_error(self, get):
+        get.side_effect = exceptions.TransportError("http error")
+        creds = credentials.IDTokenCredentials(None, "audience")
+
+        with pytest.raises(exceptions.RefreshError) as excinfo:
+            await creds.refresh(None)
+
+        assert excinfo.match(r"http error")
+
+    def test_with_target_audience(self):
+        creds = credentials.IDTokenCredentials(None, "audience", quota_project_id="p")
+
+        other = creds.with_target_audience("other")
+
+        assert isinstance(other, credentials.IDTokenCredentials)
+        assert other._target_audience == "other"
+        assert other.quota_project_id == "p"
+        assert creds.with_quota_project("q").quota_project_id == "q"
+
+
+@pytest.mark.asyncio
+async def test_fake_metadata_server():
+    with fake_metadata_server.FakeMetadataServer(service_account_email=EMAIL):
+        async with aiohttp.ClientSession(auto_decompress=False) as session:
+            request = aiohttp_requests.Request(session)
+            access = credentials.Credentials()
+            identity = credentials.IDTokenCredentials(request, "audience")
+
+            await access.refresh(request)
+            await identity.refresh(request)
+
+    assert access.token.startswith("fake-access-token-")
+    assert access.service_account_email == EMAIL
+    assert jwt._unverified_decode(identity.token)[1]["aud"] == "audience"
+    assert identity.service_account_email == EMAIL
@@ -0,0 +1,275 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import asyncio
+import datetime
+import json
+
+import aiohttp  # type: ignore
+import mock
+import pytest  # type: ignore
+from six.moves import http_client
+
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth.compute_engine import _metadata
+from google.auth.compute_engine import _metadata_async
+from google.auth.compute_engine import fake_metadata_server
+from google.auth.transport import _aiohttp_requests as aiohttp_requests
+
+PATH = "instance/service-accounts/default"
+
+
+@pytest.fixture(autouse=True)
+def sleep():
+    with mock.patch("asyncio.sleep", new_callable=mock.AsyncMock) as sleep:
+        yield sleep
+
+
+def make_response(data, status=http_client.OK, headers=None):
+    response = mock.Mock(spec=["status", "headers", "content"])
+    response.status = status
+    response.headers = {"content-type": "application/text"}
+    response.headers.update(headers or {})
+    response.content = mock.AsyncMock(return_value=_helpers.to_bytes(data))
+    return response
+
+
+def make_request(*responses):
+    return mock.AsyncMock(side_effect=list(responses))
+
+
+def json_response(data, **kwargs):
+    return make_response(
+        json.dumps(data), headers={"content-type": "application/json"}, **kwargs
+    )
+
+
+@pytest.mark.asyncio
+async def test_ping_success():
+    request = make_request(make_response("", headers=_metadata._METADATA_HEADERS))
+
+    assert await _metadata_async.ping(request)
+    request.assert_called_once_with(
+        url=_metadata._METADATA_IP_ROOT,
+        method="GET",
+        headers=_metadata._METADATA_HEADERS,
+        timeout=_metadata._METADATA_DEFAULT_TIMEOUT,
+    )
+
+
+@pytest.mark.asyncio
+async def test_ping_failure_bad_flavor():
+    request = make_request(make_response("", headers={"metadata-flavor": "meep"}))
+
+    assert not await _metadata_async.ping(request)
+
+
+@pytest.mark.asyncio
+async def test_ping_retries(sleep):
+    request = make_request(
+        exceptions.TransportError("failed"),
+        make_response("", status=http_client.SERVICE_UNAVAILABLE),
+        make_response("", headers=_metadata._METADATA_HEADERS),
+    )
+
+    assert await _metadata_async.ping(request)
+    assert request.call_count == 3
+    assert sleep.call_count == 2
+
+
+@pytest.mark.asyncio
+async def test_ping_failure_connection_failed():
+    request = make_request(*[exceptions.TransportError("failed")] * 3)
+
+    assert not await _metadata_async.ping(request)
+
+
+@pytest.mark.asyncio
+async def test_ping_deadline():
+    request = make_request(make_response("", headers=_metadata._METADATA_HEADERS))
+
+    assert await _metadata_async.ping(request, deadline=1)
+    assert request.call_args[1]["timeout"] <= 1
+
+
+@pytest.mark.asyncio
+async def test_get_success_json():
+    request = make_request(json_response({"foo": "bar"}))
+
+    assert await _metadata_async.get(request, PATH) == {"foo": "bar"}
+    request.assert_called_once_with(
+        url=_metadata._METADATA_ROOT + PATH,
+        method="GET",
+        headers=_metadata._METADATA_HEADERS,
+        timeout=_metadata_async._DEFAULT_REQUEST_TIMEOUT,
+    )
+
+
+@pytest.mark.asyncio
+async def test_get_success_text():
+    request = make_request(make_response("value"))
+
+    assert await _metadata_async.get(request, PATH, recursive=True) == "value"
+    assert request.call_args[1]["url"] == (
+        _metadata._METADATA_ROOT + PATH + "?recursive=true"
+    )
+
+
+@pytest.mark.asyncio
+async def test_get_invalid_json():
+    request = make_request(
+        make_response("{", headers={"content-type": "application/json"})
+    )
+
+    with pytest.raises(exceptions.TransportError) as excinfo:
+        await _metadata_async.get(request, PATH)
+
+    assert excinfo.match(r"invalid JSON")
+
+
+@pytest.mark.asyncio
+async def test_get_failure():
+    request = make_request(
+        make_response("Metadata error", status=http_client.NOT_FOUND)
+    )
+
+    with pytest.raises(exceptions.TransportError) as excinfo:
+        await _metadata_async.get(request, PATH)
+
+    assert excinfo.match(r"Metadata error")
+
+
+@pytest.mark.asyncio
+async def test_get_throttled(sleep):
+    request = make_request(
+        make_response("", status=429, headers={"retry-after": "2"}),
+        make_response("value"),
+    )
+
+    assert await _metadata_async.get(request, PATH) == "value"
+    assert sleep.call_args[0][0] >= 2
+
+
+@pytest.mark.asyncio
+async def test_get_unavailable():
+    request = make_request(*[exceptions.TransportError("failed")] * 5)
+
+    with pytest.raises(exceptions.TransportError) as excinfo:
+        await _metadata_async.get(request, PATH)
+
+    assert excinfo.match(r"Compute Engine Metadata server unavailable")
+    assert request.call_count == 5
+
+
+@pytest.mark.asyncio
+async def test_get_project_id():
+    request = make_request(make_response("example-project"))
+
+    assert await _metadata_async.get_project_id(request) == "example-project"
+
+
+@pytest.mark.asyncio
+async def test_get_service_account_info():
+    request = make_request(json_response({"email": "email"}))
+
+    assert await _metadata_async.get_service_account_info(request) == {
+        "email": "email"
+    }
+    assert request.call_args[1]["url"] == (
+        _metadata._METADATA_ROOT + PATH + "/?recursive=true"
+    )
+
+
+@pytest.mark.asyncio
+@mock.patch("google.auth._helpers.utcnow", return_value=datetime.datetime.min)
+async def test_get_service_account_token(utcnow):
+    request = make_request(json_response({"access_token": "token", "expires_in": 500}))
+
+    token, expiry = await _metadata_async.get_service_account_token(
+        request, scopes=["foo", "bar"]
+    )
+
+    assert token == "token"
+    assert expiry == utcnow() + datetime.timedelta(seconds=500)
+    assert request.call_args[1]["url"] == (
+        _metadata._METADATA_ROOT + PATH + "/token?scopes=foo%2Cbar"
+    )
+
+
+class TestAsyncTokenBroker(object):
+    @pytest.mark.asyncio
+    async def test_get_token_shared_with_sync_broker(self):
+        request = make_request(
+            json_response({"access_token": "token", "expires_in": 3600})
+        )
+
+        token, expiry = await _metadata_async._token_broker.get_token(
+            request, scopes=["b", "a"]
+        )
+
+        assert token == "token"
+        assert _metadata._token_broker.get_token(None, scopes="a,b") == (
+            token,
+            expiry,
+        )
+        assert request.call_count == 1
+
+    @pytest.mark.asyncio
+    async def test_get_token_stale(self):
+        request = make_request(
+            json_response({"access_token": "token", "expires_in": 3600}),
+            json_response({"access_token": "new-token", "expires_in": 3600}),
+        )
+        broker = _metadata_async._token_broker
+
+        await broker.get_token(request)
+
+        assert (await broker.get_token(request, stale_token="token"))[0] == (
+            "new-token"
+        )
+
+    @pytest.mark.asyncio
+    async def test_get_token_concurrent(self):
+        release = asyncio.Event()
+
+        async def request(**kwargs):
+            await release.wait()
+            return json_response({"access_token": "token", "expires_in": 3600})
+
+        request = mock.AsyncMock(side_effect=request)
+        tasks = [
+            asyncio.ensure_future(_metadata_async._token_broker.get_token(request))
+            for _ in range(5)
+        ]
+        # Runs once every task has started waiting for the token.
+        asyncio.get_event_loop().call_soon(release.set)
+        results = await asyncio.gather(*tasks)
+
+        assert request.call_count == 1
+        assert [token for token, _ in results] == ["token"] * 5
+
+
+@pytest.mark.asyncio
+async def test_fake_metadata_server():
+    with fake_metadata_server.FakeMetadataServer(project_id="my-project") as server:
+        server.inject_error(http_client.SERVICE_UNAVAILABLE)
+        async with aiohttp.ClientSession(auto_decompress=False) as session:
+            request = aiohttp_requests.Request(session)
+
+            assert await _metadata_async.ping(request)
+            assert await _metadata_async.get_project_id(request) == "my-project"
+            token, _ = await _metadata_async.get_service_account_token(request)
+
+    assert token.startswith("fake-access-token-")
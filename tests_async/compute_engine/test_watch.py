@@ -0,0 +1,55 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import asyncio
+import json
+import threading
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import _helpers
+from google.auth import transport
+from google.auth.compute_engine import watch
+
+
+@pytest.mark.asyncio
+async def test_coroutine_callback():
+    response = mock.create_autospec(transport.Response, instance=True)
+    response.status = 200
+    response.data = _helpers.to_bytes(json.dumps({"attributes": {"key": "value"}}))
+    response.headers = {"etag": "etag1"}
+    closed = threading.Event()
+
+    def request(url, method, headers, timeout):
+        if "wait_for_change" in url:
+            # Hold the long-poll open until the test is done.
+            closed.wait()
+        return response
+
+    loop = asyncio.get_event_loop()
+    called = asyncio.Event()
+    calls = []
+
+    async def callback(path, value):
+        assert asyncio.get_event_loop() is loop
+        calls.append((path, value))
+        called.set()
+
+    with watch.Watcher(request=request) as watcher:
+        watcher.subscribe("instance/attributes/key", callback)
+        await asyncio.wait_for(called.wait(), 5)
+    closed.set()
+
+    assert calls == [("instance/attributes/key", "value")]
@@ -18,6 +18,8 @@ import sys
 import mock
 import pytest  # type: ignore
 
+from google.auth.compute_engine import _metadata
+
 
 def pytest_configure():
     """Load public certificate and private key."""
@@ -32,6 +34,15 @@ def pytest_configure():
         pytest.public_cert_bytes = fh.read()
 
 
+@pytest.fixture(autouse=True)
+def clear_token_broker():
+    """Keeps the metadata server tokens of a test from being reused by the
+    next one."""
+    _metadata._token_broker.clear()
+    yield
+    _metadata._token_broker.clear()
+
+
 @pytest.fixture
 def mock_non_existent_module(monkeypatch):
     """Mocks a non-existing module in sys.modules.
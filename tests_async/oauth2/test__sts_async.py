@@ -0,0 +1,182 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import asyncio
+import json
+
+import mock
+import pytest  # type: ignore
+from six.moves import http_client
+from six.moves import urllib
+
+from google.auth import exceptions
+from google.oauth2 import _sts_async
+from google.oauth2 import sts
+from google.oauth2 import utils
+
+TOKEN_EXCHANGE_ENDPOINT = "https://example.com/token.oauth2"
+GRANT_TYPE = "urn:ietf:params:oauth:grant-type:token-exchange"
+SUBJECT_TOKEN = "HEADER.SUBJECT_TOKEN_PAYLOAD.SIGNATURE"
+SUBJECT_TOKEN_TYPE = "urn:ietf:params:oauth:token-type:jwt"
+AUDIENCE = "urn:example:cooperation-context"
+SCOPES = ["scope1", "scope2"]
+SUCCESS_RESPONSE = {
+    "access_token": "ACCESS_TOKEN",
+    "issued_token_type": "urn:ietf:params:oauth:token-type:access_token",
+    "token_type": "Bearer",
+    "expires_in": 3600,
+}
+ERROR_RESPONSE = {
+    "error": "invalid_request",
+    "error_description": "Invalid subject token",
+    "error_uri": "https://tools.ietf.org/html/rfc6749",
+}
+# Base64 encoding of "username:password"
+BASIC_AUTH_ENCODING = "dXNlcm5hbWU6cGFzc3dvcmQ="
+
+
+def make_response(data, status=http_client.OK):
+    response = mock.Mock(spec=["status", "content"])
+    response.status = status
+    response.content = mock.AsyncMock(return_value=json.dumps(data).encode("utf-8"))
+    return response
+
+
+def make_client(client_auth=None):
+    return _sts_async.Client(TOKEN_EXCHANGE_ENDPOINT, client_auth)
+
+
+def make_exchanges(count):
+    return [
+        {
+            "grant_type": GRANT_TYPE,
+            "subject_token": "SUBJECT_TOKEN_{}".format(index),
+            "subject_token_type": SUBJECT_TOKEN_TYPE,
+        }
+        for index in range(count)
+    ]
+
+
+async def echo_request(url, method, headers, body):
+    """Responds with an access token derived from the subject token."""
+    subject_token = dict(urllib.parse.parse_qsl(body))[b"subject_token"]
+    if subject_token == b"SUBJECT_TOKEN_1":
+        return make_response(ERROR_RESPONSE, status=http_client.BAD_REQUEST)
+    return make_response({"access_token": subject_token.decode("utf-8").lower()})
+
+
+@pytest.mark.asyncio
+async def test_exchange_token():
+    client = make_client(
+        utils.ClientAuthentication(utils.ClientAuthType.basic, "username", "password")
+    )
+    request = mock.AsyncMock(return_value=make_response(SUCCESS_RESPONSE))
+
+    response = await client.exchange_token(
+        request, GRANT_TYPE, SUBJECT_TOKEN, SUBJECT_TOKEN_TYPE, audience=AUDIENCE
+    )
+
+    assert response == SUCCESS_RESPONSE
+    kwargs = request.call_args[1]
+    assert kwargs["url"] == TOKEN_EXCHANGE_ENDPOINT
+    assert kwargs["method"] == "POST"
+    assert kwargs["headers"] == {
+        "Content-Type": "application/x-www-form-urlencoded",
+        "Authorization": "Basic {}".format(BASIC_AUTH_ENCODING),
+    }
+    assert dict(urllib.parse.parse_qsl(kwargs["body"])) == {
+        b"grant_type": GRANT_TYPE.encode("utf-8"),
+        b"subject_token": SUBJECT_TOKEN.encode("utf-8"),
+        b"subject_token_type": SUBJECT_TOKEN_TYPE.encode("utf-8"),
+        b"audience": AUDIENCE.encode("utf-8"),
+    }
+
+
+@pytest.mark.asyncio
+async def test_exchange_token_same_request_as_sync_client():
+    sync_request = mock.Mock(return_value=mock.Mock(status=200, data=b"{}"))
+    request = mock.AsyncMock(return_value=make_response({}))
+    kwargs = dict(
+        grant_type=GRANT_TYPE,
+        subject_token=SUBJECT_TOKEN,
+        subject_token_type=SUBJECT_TOKEN_TYPE,
+        audience=AUDIENCE,
+        scopes=SCOPES,
+        additional_options={"userProject": "123"},
+        additional_headers={"x-header": "value"},
+    )
+
+    await make_client().exchange_token(request, **kwargs)
+    sts.Client(TOKEN_EXCHANGE_ENDPOINT).exchange_token(sync_request, **kwargs)
+
+    assert request.call_args == sync_request.call_args
+
+
+@pytest.mark.asyncio
+async def test_exchange_token_error():
+    request = mock.AsyncMock(
+        return_value=make_response(ERROR_RESPONSE, status=http_client.BAD_REQUEST)
+    )
+
+    with pytest.raises(exceptions.OAuthError) as excinfo:
+        await make_client().exchange_token(
+            request, GRANT_TYPE, SUBJECT_TOKEN, SUBJECT_TOKEN_TYPE
+        )
+
+    assert excinfo.match(r"Error code invalid_request: Invalid subject token")
+
+
+@pytest.mark.asyncio
+async def test_exchange_tokens():
+    request = mock.AsyncMock(side_effect=echo_request)
+
+    results = await make_client().exchange_tokens(request, make_exchanges(4))
+
+    assert request.await_count == 4
+    assert [result.ok for result in results] == [True, False, True, True]
+    assert results[0].response_data == {"access_token": "subject_token_0"}
+    assert results[3].response_data == {"access_token": "subject_token_3"}
+    assert isinstance(results[1].error, exceptions.OAuthError)
+
+
+@pytest.mark.asyncio
+async def test_exchange_tokens_max_concurrency():
+    in_flight = 0
+    max_in_flight = 0
+
+    async def request(**kwargs):
+        nonlocal in_flight, max_in_flight
+        in_flight += 1
+        max_in_flight = max(max_in_flight, in_flight)
+        await asyncio.sleep(0.01)
+        in_flight -= 1
+        return await echo_request(**kwargs)
+
+    results = await make_client().exchange_tokens(
+        request, make_exchanges(10), max_concurrency=3
+    )
+
+    assert len(results) == 10
+    assert max_in_flight == 3
+
+
+@pytest.mark.asyncio
+async def test_exchange_tokens_invalid_max_concurrency():
+    request = mock.AsyncMock(side_effect=echo_request)
+
+    with pytest.raises(ValueError, match="max_concurrency"):
+        await make_client().exchange_tokens(
+            request, make_exchanges(2), max_concurrency=0
+        )
+    request.assert_not_awaited()
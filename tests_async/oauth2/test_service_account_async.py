@@ -205,6 +205,21 @@ class TestCredentials(object):
         # expired)
         assert credentials.valid
 
+    @mock.patch("google.oauth2._client_async.jwt_grant", autospec=True)
+    @pytest.mark.asyncio
+    async def test_refresh_with_jwt_credentials(self, jwt_grant):
+        credentials = self.make_credentials()
+        credentials._create_self_signed_jwt("https://pubsub.googleapis.com/")
+        request = mock.create_autospec(transport.Request, instance=True)
+
+        await credentials.refresh(request)
+
+        assert credentials.valid
+        payload = jwt.decode(credentials.token, test_service_account.PUBLIC_CERT_BYTES)
+        assert payload["aud"] == "https://pubsub.googleapis.com/"
+        jwt_grant.assert_not_called()
+        request.assert_not_called()
+
     @mock.patch("google.oauth2._client_async.jwt_grant", autospec=True)
     @pytest.mark.asyncio
     async def test_before_request_refreshes(self, jwt_grant):
@@ -19,11 +19,13 @@ import mock
 import pytest  # type: ignore
 
 from google.auth import _credentials_async as credentials
+from google.auth import _default as _default_sync
 from google.auth import _default_async as _default
 from google.auth import app_engine
 from google.auth import compute_engine
 from google.auth import environment_vars
 from google.auth import exceptions
+from google.auth.compute_engine import _credentials_async as compute_engine_async
 from google.oauth2 import _service_account_async as service_account
 import google.oauth2.credentials
 from tests import test__default as test_default
@@ -38,6 +40,13 @@ LOAD_FILE_PATCH = mock.patch(
 )
 
 
+@pytest.fixture(autouse=True)
+def reset_environment_detection():
+    _default_sync._reset_environment_detection()
+    yield
+    _default_sync._reset_environment_detection()
+
+
 def test_load_credentials_from_missing_file():
     with pytest.raises(exceptions.DefaultCredentialsError) as excinfo:
         _default.load_credentials_from_file("")
@@ -376,7 +385,7 @@ def test__get_gae_credentials_no_apis():
 def test__get_gce_credentials(unused_get, unused_ping):
     credentials, project_id = _default._get_gce_credentials()
 
-    assert isinstance(credentials, compute_engine.Credentials)
+    assert isinstance(credentials, compute_engine_async.Credentials)
     assert project_id == "example-project"
 
 
@@ -420,7 +429,9 @@ def test__get_gce_credentials_no_compute_engine():
 )
 def test__get_gce_credentials_explicit_request(ping):
     _default._get_gce_credentials(mock.sentinel.request)
-    ping.assert_called_with(request=mock.sentinel.request)
+    ping.assert_called_with(
+        request=mock.sentinel.request, deadline=_default_sync._METADATA_PING_DEADLINE
+    )
 
 
 @mock.patch(
@@ -0,0 +1,62 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import _exponential_backoff_async
+
+
+@pytest.fixture(autouse=True)
+def sleep():
+    with mock.patch("asyncio.sleep", new_callable=mock.AsyncMock) as sleep:
+        yield sleep
+
+
+async def collect(backoff):
+    return [attempt async for attempt in backoff]
+
+
+@pytest.mark.asyncio
+@mock.patch("random.uniform", side_effect=lambda low, high: high, autospec=True)
+async def test_backoff(uniform, sleep):
+    backoff = _exponential_backoff_async.AsyncExponentialBackoff(
+        total_attempts=4, initial_delay=1, max_delay=3, multiplier=2
+    )
+
+    assert await collect(backoff) == [1, 2, 3, 4]
+    assert await collect(backoff) == [1, 2, 3, 4]
+    assert sleep.call_args_list == [mock.call(1), mock.call(2), mock.call(3)] * 2
+
+
+@pytest.mark.asyncio
+@mock.patch("random.uniform", return_value=0.5, autospec=True)
+async def test_retry_after(unused_uniform, sleep):
+    backoff = _exponential_backoff_async.AsyncExponentialBackoff(total_attempts=2)
+
+    async for attempt in backoff:
+        backoff.retry_after(5)
+
+    sleep.assert_called_once_with(5)
+
+
+@pytest.mark.asyncio
+@mock.patch("random.uniform", return_value=2, autospec=True)
+async def test_deadline(unused_uniform, sleep):
+    backoff = _exponential_backoff_async.AsyncExponentialBackoff(
+        total_attempts=5, deadline=1
+    )
+
+    assert await collect(backoff) == [1]
+    sleep.assert_not_called()
@@ -12,12 +12,18 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import asyncio
+import datetime
+
 import aiohttp  # type: ignore
 from aioresponses import aioresponses, core  # type: ignore
 import mock
 import pytest  # type: ignore
 from tests_async.transport import async_compliance
 
+from google.auth import _helpers
+from google.auth import exceptions
+from google.auth import instrumentation
 import google.auth._credentials_async
 from google.auth.transport import _aiohttp_requests as aiohttp_requests
 import google.auth.transport._mtls_helper
@@ -140,6 +146,205 @@ class CredentialsStub(google.auth._credentials_async.Credentials):
         self.token += "1"
 
 
+class AsyncCredentialsStub(google.auth._credentials_async.Credentials):
+    def __init__(self, token=None, expiry=None):
+        super(AsyncCredentialsStub, self).__init__()
+        self.token = token
+        self.expiry = expiry
+        self.refresh_count = 0
+        self.refresh_started = asyncio.Event()
+        self.release = asyncio.Event()
+
+    async def refresh(self, request):
+        self.refresh_count += 1
+        self.refresh_request = request
+        self.refresh_started.set()
+        await self.release.wait()
+        self.token = "token{}".format(self.refresh_count)
+        self.expiry = _helpers.utcnow() + datetime.timedelta(hours=1)
+
+
+def make_manager(credentials, **kwargs):
+    kwargs.setdefault("auth_request", mock.sentinel.request)
+    return aiohttp_requests._RefreshManager(credentials, **kwargs)
+
+
+class TestRefreshManager(object):
+    @pytest.mark.asyncio
+    async def test_before_request_single_flight(self):
+        credentials = AsyncCredentialsStub()
+        manager = make_manager(credentials)
+
+        waiters = [
+            asyncio.ensure_future(manager.before_request())
+            for _ in range(1000)
+        ]
+        await credentials.refresh_started.wait()
+        credentials.release.set()
+        await asyncio.gather(*waiters)
+
+        assert credentials.refresh_count == 1
+        assert credentials.token == "token1"
+
+    @pytest.mark.asyncio
+    async def test_before_request_valid(self):
+        credentials = AsyncCredentialsStub(
+            token="token", expiry=_helpers.utcnow() + datetime.timedelta(hours=1)
+        )
+        manager = make_manager(credentials)
+
+        await manager.before_request()
+
+        assert credentials.refresh_count == 0
+
+    @pytest.mark.asyncio
+    async def test_before_request_refresh_ahead(self):
+        credentials = AsyncCredentialsStub(
+            token="token", expiry=_helpers.utcnow() + datetime.timedelta(minutes=1)
+        )
+        manager = make_manager(credentials)
+
+        # The current token is still valid, so the caller does not wait for
+        # the refresh to finish.
+        await manager.before_request()
+        await manager.before_request()
+        await credentials.refresh_started.wait()
+        assert credentials.token == "token"
+
+        credentials.release.set()
+        await manager._tasks[asyncio.get_event_loop()]
+
+        assert credentials.refresh_count == 1
+        assert credentials.token == "token1"
+
+    @pytest.mark.asyncio
+    async def test_refresh_outlives_cancelled_caller(self):
+        credentials = AsyncCredentialsStub()
+        manager = aiohttp_requests._RefreshManager(credentials)
+
+        first = asyncio.ensure_future(manager.refresh())
+        await credentials.refresh_started.wait()
+        second = asyncio.ensure_future(manager.refresh())
+        first.cancel()
+        with pytest.raises(asyncio.CancelledError):
+            await first
+
+        # The shared refresh runs on the manager's session, which is still
+        # open after the caller that started the refresh is gone.
+        request = credentials.refresh_request
+        assert request is manager.get_request()
+        assert not request.session.closed
+        credentials.release.set()
+        await second
+        assert credentials.token == "token1"
+
+        await manager.close()
+        assert request.session.closed
+
+    @pytest.mark.asyncio
+    async def test_refresh_timeout(self):
+        credentials = mock.Mock(wraps=CredentialsStub(), expiry=None)
+        auth_request = mock.Mock()
+        manager = aiohttp_requests._RefreshManager(
+            credentials, refresh_timeout=5, auth_request=auth_request
+        )
+
+        await manager.refresh()
+
+        request = credentials.refresh.call_args[0][0]
+        assert request.func is auth_request
+        assert request.keywords == {"timeout": 5}
+
+    @pytest.mark.asyncio
+    async def test_before_request_refresh_ahead_auth_request(self):
+        credentials = AsyncCredentialsStub(
+            token="token", expiry=_helpers.utcnow() + datetime.timedelta(minutes=1)
+        )
+        credentials.release.set()
+        credentials.refresh = mock.Mock(wraps=credentials.refresh)
+        manager = aiohttp_requests._RefreshManager(
+            credentials, auth_request=mock.sentinel.auth_request
+        )
+
+        await manager.before_request()
+        await manager._tasks[asyncio.get_event_loop()]
+
+        credentials.refresh.assert_called_once_with(mock.sentinel.auth_request)
+
+    @pytest.mark.asyncio
+    async def test_before_request_expiry_not_datetime(self):
+        credentials = mock.Mock(wraps=CredentialsStub())
+        manager = make_manager(credentials)
+
+        await manager.before_request()
+
+        credentials.refresh.assert_not_called()
+
+    @pytest.mark.asyncio
+    async def test_refresh_sync_credentials(self):
+        credentials = mock.Mock(wraps=CredentialsStub(), expiry=None)
+        manager = aiohttp_requests._RefreshManager(
+            credentials, auth_request=mock.sentinel.request
+        )
+
+        await manager.refresh()
+
+        credentials.refresh.assert_called_once_with(mock.sentinel.request)
+
+    @pytest.mark.asyncio
+    async def test_refresh_traced(self):
+        credentials = AsyncCredentialsStub()
+        credentials.release.set()
+        manager = make_manager(credentials)
+        recorder = mock.create_autospec(instrumentation.Instrumentation, instance=True)
+        instrumentation.set_instrumentation(recorder)
+        try:
+            await manager.refresh()
+        finally:
+            instrumentation.set_instrumentation(None)
+
+        recorder.start_span.assert_called_once_with(
+            "google.auth.credentials.refresh", {"credentials": "AsyncCredentialsStub"}
+        )
+
+    @pytest.mark.asyncio
+    async def test_refresh_stale_token_already_replaced(self):
+        credentials = AsyncCredentialsStub(token="new")
+        manager = make_manager(credentials)
+
+        await manager.refresh(stale_token="old")
+
+        assert credentials.refresh_count == 0
+
+    @pytest.mark.asyncio
+    async def test_refresh_error_shared(self):
+        credentials = mock.Mock(wraps=CredentialsStub(), expiry=None)
+        credentials.refresh.side_effect = exceptions.RefreshError("failed")
+        manager = make_manager(credentials)
+
+        results = await asyncio.gather(
+            manager.refresh(),
+            manager.refresh(),
+            return_exceptions=True,
+        )
+
+        assert credentials.refresh.call_count == 1
+        assert all(isinstance(r, exceptions.RefreshError) for r in results)
+
+    @pytest.mark.asyncio
+    async def test_close(self):
+        credentials = AsyncCredentialsStub()
+        manager = make_manager(credentials)
+
+        waiter = asyncio.ensure_future(manager.refresh())
+        await credentials.refresh_started.wait()
+        await manager.close()
+
+        with pytest.raises(asyncio.CancelledError):
+            await waiter
+        assert not manager._tasks
+
+
 class TestAuthorizedSession(object):
     TEST_URL = "http://example.com/"
     method = "GET"
@@ -0,0 +1,253 @@
+# Copyright 2022 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import mock
+import pytest  # type: ignore
+
+from google.auth import _credentials_async
+from google.auth import credentials
+from google.auth import jwt
+from google.oauth2 import _service_account_async
+from tests.oauth2 import test_service_account
+
+try:
+    # pylint: disable=ungrouped-imports
+    import grpc  # type: ignore
+    from grpc import aio  # type: ignore
+    from google.auth.transport import _grpc_aio
+
+    HAS_GRPC = True
+except ImportError:  # pragma: NO COVER
+    HAS_GRPC = False
+
+pytestmark = pytest.mark.skipif(not HAS_GRPC, reason="gRPC is unavailable.")
+
+_SERVICE = "google.auth.test.Echo"
+
+
+class CredentialsStub(_credentials_async.Credentials):
+    def __init__(self, token=None):
+        super(CredentialsStub, self).__init__()
+        self.token = token
+        self.refresh_count = 0
+
+    async def refresh(self, request):
+        self.refresh_count += 1
+        self.token = "token{}".format(self.refresh_count)
+
+
+class SyncCredentialsStub(credentials.Credentials):
+    def __init__(self, token="token"):
+        super(SyncCredentialsStub, self).__init__()
+        self.token = token
+
+    def refresh(self, request):
+        self.token += "1"
+
+
+class TestAuthMetadataPlugin(object):
+    @pytest.mark.asyncio
+    async def test_call_refresh(self):
+        credentials = CredentialsStub()
+        plugin = _grpc_aio.AuthMetadataPlugin(credentials, mock.sentinel.request)
+
+        metadata = await plugin("Echo", "https://example.com/" + _SERVICE)
+
+        assert credentials.refresh_count == 1
+        assert metadata == [("authorization", "Bearer token1")]
+
+    @pytest.mark.asyncio
+    async def test_call_no_refresh(self):
+        credentials = CredentialsStub(token="token")
+        plugin = _grpc_aio.AuthMetadataPlugin(credentials, mock.sentinel.request)
+
+        metadata = await plugin("Echo", "https://example.com/" + _SERVICE)
+
+        assert credentials.refresh_count == 0
+        assert metadata == [("authorization", "Bearer token")]
+
+    @pytest.mark.asyncio
+    async def test_call_sync_credentials(self):
+        credentials = SyncCredentialsStub()
+        plugin = _grpc_aio.AuthMetadataPlugin(credentials, mock.sentinel.request)
+
+        metadata = await plugin("Echo", "https://example.com/" + _SERVICE)
+
+        assert metadata == [("authorization", "Bearer token")]
+
+    @pytest.mark.asyncio
+    async def test_call_refresh_uses_request(self):
+        credentials = CredentialsStub()
+        credentials.refresh = mock.AsyncMock(wraps=credentials.refresh)
+        plugin = _grpc_aio.AuthMetadataPlugin(credentials, mock.sentinel.request)
+
+        await plugin("Echo", "https://example.com/" + _SERVICE)
+
+        credentials.refresh.assert_awaited_once_with(mock.sentinel.request)
+
+    @pytest.mark.asyncio
+    async def test_service_account_self_signed_jwt_shared(self):
+        credentials = _service_account_async.Credentials.from_service_account_info(
+            test_service_account.SERVICE_ACCOUNT_INFO
+        )
+        request = mock.AsyncMock()
+        plugin = _grpc_aio.AuthMetadataPlugin(
+            credentials, request, default_host="pubsub.googleapis.com"
+        )
+        other_plugin = _grpc_aio.AuthMetadataPlugin(
+            credentials, request, default_host="storage.googleapis.com"
+        )
+
+        audiences = []
+        for current in (plugin, other_plugin, plugin):
+            metadata = dict(await current("Echo", "https://example.com/" + _SERVICE))
+            token = metadata["authorization"].split(" ", 1)[1]
+            audiences.append(
+                jwt.decode(token, test_service_account.PUBLIC_CERT_BYTES)["aud"]
+            )
+
+        # Each plugin sends a JWT for its own host, without a token request.
+        assert audiences == [
+            "https://pubsub.googleapis.com/",
+            "https://storage.googleapis.com/",
+            "https://pubsub.googleapis.com/",
+        ]
+        request.assert_not_called()
+
+
+class TestInterceptors(object):
+    def test_auth_interceptors(self):
+        interceptors = _grpc_aio.auth_interceptors(
+            mock.sentinel.plugin, "example.com:443"
+        )
+
+        assert [type(interceptor) for interceptor in interceptors] == [
+            _grpc_aio._UnaryUnaryInterceptor,
+            _grpc_aio._UnaryStreamInterceptor,
+            _grpc_aio._StreamUnaryInterceptor,
+            _grpc_aio._StreamStreamInterceptor,
+        ]
+        assert all(interceptor._host == "example.com" for interceptor in interceptors)
+
+    @pytest.mark.parametrize(
+        "target, host",
+        [
+            ("example.com", "example.com"),
+            ("example.com:443", "example.com"),
+            ("dns:///example.com:443", "example.com"),
+            ("dns://8.8.8.8/example.com", "example.com"),
+            ("dns:example.com:443", "example.com"),
+            ("[::1]:8080", "[::1]"),
+            ("::1", "[::1]"),
+            ("dns:///[2001:db8::1]:443", "[2001:db8::1]"),
+            ("ipv4:10.0.0.1:443,10.0.0.2:443", "10.0.0.1"),
+            ("ipv6:[::1]:443", "[::1]"),
+            ("unix:/tmp/socket", "localhost"),
+        ],
+    )
+    def test__target_host(self, target, host):
+        assert _grpc_aio._target_host(target) == host
+
+    @pytest.mark.asyncio
+    async def test_intercept(self):
+        plugin = mock.AsyncMock(return_value=[("authorization", "Bearer token")])
+        details = aio.ClientCallDetails(
+            method="/{}/Echo".format(_SERVICE).encode(),
+            timeout=None,
+            metadata=(("x-goog-request-params", "a=b"),),
+            credentials=None,
+            wait_for_ready=None,
+        )
+        continuation = mock.AsyncMock(return_value=mock.sentinel.call)
+
+        for interceptor, intercept in zip(
+            _grpc_aio.auth_interceptors(plugin, "example.com"),
+            ("unary_unary", "unary_stream", "stream_unary", "stream_stream"),
+        ):
+            call = await getattr(interceptor, "intercept_" + intercept)(
+                continuation, details, mock.sentinel.request
+            )
+
+            assert call == mock.sentinel.call
+            plugin.assert_called_with("Echo", "https://example.com/" + _SERVICE)
+            continuation.assert_called_with(
+                details._replace(
+                    metadata=(
+                        ("x-goog-request-params", "a=b"),
+                        ("authorization", "Bearer token"),
+                    )
+                ),
+                mock.sentinel.request,
+            )
+
+
+class TestSecureAuthorizedAioChannel(object):
+    @pytest.mark.asyncio
+    async def test_local_server(self):
+        async def echo(request, context):
+            metadata = dict(context.invocation_metadata())
+            return metadata["authorization"].encode()
+
+        server = aio.server()
+        server.add_generic_rpc_handlers(
+            (
+                grpc.method_handlers_generic_handler(
+                    _SERVICE, {"Echo": grpc.unary_unary_rpc_method_handler(echo)}
+                ),
+            )
+        )
+        port = server.add_secure_port("localhost:0", grpc.local_server_credentials())
+        await server.start()
+
+        credentials = CredentialsStub()
+        channel = _grpc_aio.secure_authorized_aio_channel(
+            credentials,
+            mock.sentinel.request,
+            "localhost:{}".format(port),
+            ssl_credentials=grpc.local_channel_credentials(),
+        )
+        try:
+            echo_method = channel.unary_unary("/{}/Echo".format(_SERVICE))
+            assert await echo_method(b"") == b"Bearer token1"
+            assert await echo_method(b"") == b"Bearer token1"
+        finally:
+            await channel.close()
+            await server.stop(None)
+
+        assert credentials.refresh_count == 1
+
+    @mock.patch("google.auth.transport.grpc._get_ssl_credentials", autospec=True)
+    @mock.patch("grpc.aio.secure_channel", autospec=True)
+    def test_secure_authorized_aio_channel(
+        self, secure_channel, get_ssl_credentials
+    ):
+        channel = _grpc_aio.secure_authorized_aio_channel(
+            CredentialsStub(),
+            mock.sentinel.request,
+            "example.com:443",
+            client_cert_callback=mock.sentinel.callback,
+            default_host="example.com",
+            interceptors=[mock.sentinel.interceptor],
+            options=mock.sentinel.options,
+        )
+
+        assert channel == secure_channel.return_value
+        get_ssl_credentials.assert_called_once_with(None, mock.sentinel.callback)
+        args, kwargs = secure_channel.call_args
+        assert args == ("example.com:443", get_ssl_credentials.return_value)
+        assert kwargs["options"] == mock.sentinel.options
+        interceptors = kwargs["interceptors"]
+        assert len(interceptors) == 5
+        assert interceptors[0] == mock.sentinel.interceptor
+        assert interceptors[1]._plugin._default_host == "example.com"